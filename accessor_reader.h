@@ -0,0 +1,198 @@
+// Odczyt accessorów glTF do tablic typu T z uwzględnieniem byteStride,
+// typu składowej (BYTE..FLOAT), flagi normalized i accessorów sparse.
+// Używane tam, gdzie dane nie nadają się do bezpośredniego odczytu jako float
+// (np. KHR_mesh_quantization: pozycje SHORT, normalne BYTE normalized).
+#ifndef ACCESSOR_READER_H_
+#define ACCESSOR_READER_H_
+
+#include <GLES2/gl2.h>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include "tiny_gltf.h"
+
+// Surowy widok accessora: wskaźnik na pierwszy element i krok w bajtach
+struct AccessorData {
+    const unsigned char* data = nullptr; // nullptr, gdy accessor nie ma bufferView (same zera + sparse)
+    size_t stride = 0;
+    size_t count = 0;
+    int componentType = -1;
+    int components = 0;
+    bool normalized = false;
+    bool sparse = false;
+};
+
+// --- Widok accessora ze sprawdzeniem zakresu bufora ---
+inline bool GetAccessorData(const tinygltf::Model& model, const tinygltf::Accessor& accessor, AccessorData& out) {
+    out = AccessorData();
+    out.count = accessor.count;
+    out.componentType = accessor.componentType;
+    out.components = tinygltf::GetNumComponentsInType(static_cast<uint32_t>(accessor.type));
+    out.normalized = accessor.normalized;
+    out.sparse = accessor.sparse.isSparse;
+
+    const int componentSize = tinygltf::GetComponentSizeInBytes(static_cast<uint32_t>(accessor.componentType));
+    if (componentSize <= 0 || out.components <= 0) {
+        std::cerr << "Accessor: nieznany typ " << accessor.componentType << "/" << accessor.type << "\n";
+        return false;
+    }
+    if (accessor.bufferView < 0) return true; // Dozwolone dla sparse - baza to zera
+
+    const auto& view = model.bufferViews[accessor.bufferView];
+    const int stride = accessor.ByteStride(view);
+    if (stride <= 0) {
+        std::cerr << "Accessor: niepoprawny byteStride " << view.byteStride << "\n";
+        return false;
+    }
+    const auto& buffer = model.buffers[view.buffer];
+    const size_t begin = view.byteOffset + accessor.byteOffset;
+    const size_t elementSize = (size_t)componentSize * out.components;
+    if (accessor.count > 0 && begin + (accessor.count - 1) * (size_t)stride + elementSize > buffer.DataSize()) {
+        std::cerr << "Accessor: dane poza buforem\n";
+        return false;
+    }
+    out.data = buffer.DataPtr() + begin;
+    out.stride = (size_t)stride;
+    return true;
+}
+
+namespace accessor_detail {
+
+template <typename Src>
+inline Src LoadUnaligned(const unsigned char* p) {
+    Src v;
+    std::memcpy(&v, p, sizeof(Src));
+    return v;
+}
+
+// Konwersja jednej składowej. Dla float z normalized - wzory ze specyfikacji glTF
+// (max(c / 127, -1) itd.), dla typów całkowitych - zwykłe rzutowanie.
+template <typename T, typename Src>
+inline T Convert(Src v, bool normalized) {
+    if (std::is_floating_point<T>::value && normalized && !std::is_floating_point<Src>::value) {
+        const double maxValue = (double)std::numeric_limits<Src>::max();
+        return (T)std::max((double)v / maxValue, -1.0);
+    }
+    return (T)v;
+}
+
+template <typename T, typename Src>
+inline void ReadElements(const unsigned char* data, size_t stride, size_t count, int components, bool normalized,
+                         T* out, int outComponents) {
+    const int n = std::min(components, outComponents);
+    for (size_t i = 0; i < count; ++i) {
+        const unsigned char* element = data + i * stride;
+        T* dst = out + i * outComponents;
+        for (int c = 0; c < n; ++c) dst[c] = Convert<T>(LoadUnaligned<Src>(element + c * sizeof(Src)), normalized);
+    }
+}
+
+// Jedna instrukcja switch na wywołanie - pętla już zna typ źródłowy
+template <typename T>
+inline bool ReadElementsAny(const unsigned char* data, size_t stride, size_t count, int componentType, int components,
+                            bool normalized, T* out, int outComponents) {
+    switch (componentType) {
+    case TINYGLTF_COMPONENT_TYPE_BYTE: ReadElements<T, int8_t>(data, stride, count, components, normalized, out, outComponents); return true;
+    case TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE: ReadElements<T, uint8_t>(data, stride, count, components, normalized, out, outComponents); return true;
+    case TINYGLTF_COMPONENT_TYPE_SHORT: ReadElements<T, int16_t>(data, stride, count, components, normalized, out, outComponents); return true;
+    case TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT: ReadElements<T, uint16_t>(data, stride, count, components, normalized, out, outComponents); return true;
+    case TINYGLTF_COMPONENT_TYPE_INT: ReadElements<T, int32_t>(data, stride, count, components, normalized, out, outComponents); return true;
+    case TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT: ReadElements<T, uint32_t>(data, stride, count, components, normalized, out, outComponents); return true;
+    case TINYGLTF_COMPONENT_TYPE_FLOAT: ReadElements<T, float>(data, stride, count, components, normalized, out, outComponents); return true;
+    case TINYGLTF_COMPONENT_TYPE_DOUBLE: ReadElements<T, double>(data, stride, count, components, normalized, out, outComponents); return true;
+    default: return false;
+    }
+}
+
+}  // namespace accessor_detail
+
+// --- Accessor do ciasnej tablicy count * outComponents elementów T ---
+// outComponents == 0 oznacza liczbę składowych z typu accessora. Brakujące
+// składowe (accessor węższy niż outComponents) pozostają zerami.
+template <typename T>
+inline bool ReadAccessor(const tinygltf::Model& model, const tinygltf::Accessor& accessor, std::vector<T>& out,
+                         int outComponents = 0) {
+    AccessorData view;
+    if (!GetAccessorData(model, accessor, view)) return false;
+    if (outComponents <= 0) outComponents = view.components;
+
+    out.assign(view.count * (size_t)outComponents, T(0));
+    if (view.data && !accessor_detail::ReadElementsAny(view.data, view.stride, view.count, view.componentType,
+                                                       view.components, view.normalized, out.data(), outComponents)) {
+        return false;
+    }
+    if (!view.sparse) return true;
+
+    // Sparse: indeksy (UBYTE/USHORT/UINT) i ciasno upakowane wartości nadpisujące bazę
+    const auto& sparse = accessor.sparse;
+    if (sparse.count <= 0) return true;
+    if (sparse.indices.bufferView < 0 || sparse.values.bufferView < 0) {
+        std::cerr << "Accessor sparse bez bufferView\n";
+        return false;
+    }
+
+    std::vector<uint32_t> sparseIndices(sparse.count);
+    {
+        const auto& indexView = model.bufferViews[sparse.indices.bufferView];
+        const auto& indexBuffer = model.buffers[indexView.buffer];
+        const int indexSize = tinygltf::GetComponentSizeInBytes(static_cast<uint32_t>(sparse.indices.componentType));
+        const size_t begin = indexView.byteOffset + sparse.indices.byteOffset;
+        if (indexSize <= 0 || begin + (size_t)indexSize * sparse.count > indexBuffer.DataSize() ||
+            !accessor_detail::ReadElementsAny(indexBuffer.DataPtr() + begin, indexSize, sparse.count,
+                                              sparse.indices.componentType, 1, false, sparseIndices.data(), 1)) {
+            std::cerr << "Accessor sparse: niepoprawne indeksy\n";
+            return false;
+        }
+    }
+
+    std::vector<T> values(sparse.count * (size_t)outComponents, T(0));
+    {
+        const auto& valueView = model.bufferViews[sparse.values.bufferView];
+        const auto& valueBuffer = model.buffers[valueView.buffer];
+        const size_t elementSize =
+            (size_t)tinygltf::GetComponentSizeInBytes(static_cast<uint32_t>(view.componentType)) * view.components;
+        const size_t begin = valueView.byteOffset + sparse.values.byteOffset;
+        if (begin + elementSize * sparse.count > valueBuffer.DataSize()) {
+            std::cerr << "Accessor sparse: wartosci poza buforem\n";
+            return false;
+        }
+        accessor_detail::ReadElementsAny(valueBuffer.DataPtr() + begin, elementSize, sparse.count, view.componentType,
+                                         view.components, view.normalized, values.data(), outComponents);
+    }
+
+    for (int i = 0; i < sparse.count; ++i) {
+        if (sparseIndices[i] >= view.count) continue;
+        std::copy(values.begin() + (size_t)i * outComponents, values.begin() + (size_t)(i + 1) * outComponents,
+                  out.begin() + (size_t)sparseIndices[i] * outComponents);
+    }
+    return true;
+}
+
+// --- Czy accessor można odczytać bezpośrednio z bufora jako float[components] ---
+// (bez konwersji i bez sparse) - wtedy GatherVertices czyta go z pominięciem kopii,
+// a dane można też przekazać do glVertexAttribPointer prosto z bufferView.
+inline bool IsDirectFloatAccessor(const AccessorData& view, int components) {
+    return view.data && !view.sparse && view.componentType == TINYGLTF_COMPONENT_TYPE_FLOAT && view.components == components;
+}
+
+// --- Format atrybutu GL dla accessora (bez repackingu); false, gdy GLES2 go nie obsługuje ---
+inline bool AccessorGLFormat(const AccessorData& view, GLenum& type, GLboolean& normalized) {
+    switch (view.componentType) {
+    case TINYGLTF_COMPONENT_TYPE_BYTE: type = GL_BYTE; break;
+    case TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE: type = GL_UNSIGNED_BYTE; break;
+    case TINYGLTF_COMPONENT_TYPE_SHORT: type = GL_SHORT; break;
+    case TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT: type = GL_UNSIGNED_SHORT; break;
+    case TINYGLTF_COMPONENT_TYPE_FLOAT: type = GL_FLOAT; break;
+    default: return false; // INT/UINT/DOUBLE nie są formatami atrybutów w GLES2
+    }
+    normalized = view.normalized ? GL_TRUE : GL_FALSE;
+    return !view.sparse && view.data && view.stride <= 255; // WebGL1: maks. stride to 255
+}
+
+#endif  // ACCESSOR_READER_H_
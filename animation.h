@@ -0,0 +1,343 @@
+// Animacje glTF (translation / rotation / scale węzłów i wagi morph targetów)
+// przekonwertowane przy ładowaniu do ciągłych tablic klipu: czasy kluczy
+// wszystkich samplerów w jednej tablicy, wartości w drugiej (SoA - szukanie
+// przedziału czyta tylko czasy). Dane nie odwołują się do buforów modelu, więc
+// animacje działają także po ReleaseModelBuffers.
+//
+// Próbkowanie z kursorem: każdy sampler pamięta ostatni przedział kluczy i przy
+// rosnącym czasie przesuwa go o kilka pozycji do przodu, bez wyszukiwania
+// binarnego. Cofnięcie czasu (zapętlenie, przewinięcie) zaczyna od pierwszego klucza.
+// Interpolacje: LINEAR (obrót - slerp), STEP i CUBICSPLINE (Hermite ze stycznymi z pliku).
+#ifndef ANIMATION_H_
+#define ANIMATION_H_
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "accessor_reader.h"
+#include "tiny_gltf.h"
+#include <glm/glm.hpp>
+
+enum class AnimationPath : uint8_t { Translation, Rotation, Scale, Weights };
+enum class Interpolation : uint8_t { Linear, Step, CubicSpline };
+
+struct AnimationSampler {
+    uint32_t firstTime = 0;  // Pierwszy klucz w AnimationClip::times
+    uint32_t keyCount = 0;
+    uint32_t firstValue = 0; // Pierwsza wartość w AnimationClip::values
+    uint32_t components = 0; // 3 (T, S), 4 (R) albo liczba wag
+    Interpolation interpolation = Interpolation::Linear;
+};
+
+struct AnimationChannel {
+    uint32_t sampler = 0;
+    int node = -1;
+    AnimationPath path = AnimationPath::Translation;
+};
+
+struct AnimationClip {
+    std::string name;
+    float start = 0, end = 0; // Zakres czasów kluczy wszystkich samplerów
+    std::vector<float> times;
+    std::vector<float> values; // CUBICSPLINE: na klucz [styczna wejściowa, wartość, styczna wyjściowa]
+    std::vector<AnimationSampler> samplers;
+    std::vector<AnimationChannel> channels;
+
+    float Duration() const { return end - start; }
+};
+
+// Poza węzłów w SoA: osobna tablica dla każdej składowej TRS, wagi wszystkich węzłów w jednej
+struct NodePose {
+    std::vector<glm::vec3> translation;
+    std::vector<glm::vec4> rotation; // Kwaternion x, y, z, w (kolejność glTF)
+    std::vector<glm::vec3> scale;
+    std::vector<float> weights;
+    std::vector<uint32_t> weightOffset; // Wagi węzła i: [weightOffset[i], weightOffset[i + 1])
+    std::vector<uint8_t> matrix;        // Węzeł z macierzą - glTF nie pozwala go animować
+    std::vector<uint8_t> changed;       // Zmienione TRS (nie wagi); ustawia SampleClip, kasuje odbiorca
+
+    size_t Size() const { return translation.size(); }
+    uint32_t WeightCount(int node) const { return weightOffset[node + 1] - weightOffset[node]; }
+};
+
+// Przedział kluczy każdego samplera: times[k] <= t < times[k + 1]
+struct AnimationCursor {
+    std::vector<uint32_t> keys;
+
+    void Reset(const AnimationClip& clip) { keys.assign(clip.samplers.size(), 0); }
+};
+
+// --- Liczba wag morph targetów węzła (node.weights, mesh.weights albo liczba targetów) ---
+inline uint32_t NodeWeightCount(const tinygltf::Model& model, const tinygltf::Node& node) {
+    if (!node.weights.empty()) return (uint32_t)node.weights.size();
+    if (node.mesh < 0 || node.mesh >= (int)model.meshes.size()) return 0;
+    const auto& mesh = model.meshes[node.mesh];
+    if (!mesh.weights.empty()) return (uint32_t)mesh.weights.size();
+    return mesh.primitives.empty() ? 0 : (uint32_t)mesh.primitives[0].targets.size();
+}
+
+// --- Poza spoczynkowa z węzłów modelu ---
+inline void InitNodePose(const tinygltf::Model& model, NodePose& pose) {
+    const size_t count = model.nodes.size();
+    pose.translation.assign(count, glm::vec3(0.0f));
+    pose.rotation.assign(count, glm::vec4(0.0f, 0.0f, 0.0f, 1.0f));
+    pose.scale.assign(count, glm::vec3(1.0f));
+    pose.matrix.assign(count, 0);
+    pose.changed.assign(count, 0);
+    pose.weightOffset.assign(count + 1, 0);
+    for (size_t i = 0; i < count; ++i) pose.weightOffset[i + 1] = pose.weightOffset[i] + NodeWeightCount(model, model.nodes[i]);
+    pose.weights.assign(pose.weightOffset[count], 0.0f);
+
+    for (size_t i = 0; i < count; ++i) {
+        const auto& node = model.nodes[i];
+        pose.matrix[i] = node.matrix.size() == 16;
+        if (node.translation.size() == 3) pose.translation[i] = glm::vec3(node.translation[0], node.translation[1], node.translation[2]);
+        if (node.rotation.size() == 4) {
+            pose.rotation[i] = glm::vec4(node.rotation[0], node.rotation[1], node.rotation[2], node.rotation[3]);
+        }
+        if (node.scale.size() == 3) pose.scale[i] = glm::vec3(node.scale[0], node.scale[1], node.scale[2]);
+
+        const std::vector<double>* weights = &node.weights;
+        if (weights->empty() && node.mesh >= 0 && node.mesh < (int)model.meshes.size()) weights = &model.meshes[node.mesh].weights;
+        const uint32_t n = std::min<uint32_t>(pose.WeightCount((int)i), (uint32_t)weights->size());
+        for (uint32_t w = 0; w < n; ++w) pose.weights[pose.weightOffset[i] + w] = (float)(*weights)[w];
+    }
+}
+
+// --- Konwersja model.animations do klipów; kanały, których nie da się odtworzyć, są pomijane ---
+inline void ExtractAnimations(const tinygltf::Model& model, std::vector<AnimationClip>& clips) {
+    clips.clear();
+    for (size_t a = 0; a < model.animations.size(); ++a) {
+        const auto& animation = model.animations[a];
+        AnimationClip clip;
+        clip.name = animation.name.empty() ? "animacja " + std::to_string(a) : animation.name;
+        clip.start = INFINITY;
+        clip.end = -INFINITY;
+
+        // Indeks samplera glTF -> indeks w clip.samplers (-1 = odrzucony)
+        std::vector<int> samplerMap(animation.samplers.size(), -1);
+        std::vector<float> times, values;
+        for (size_t s = 0; s < animation.samplers.size(); ++s) {
+            const auto& source = animation.samplers[s];
+            if (source.input < 0 || source.input >= (int)model.accessors.size() || source.output < 0 ||
+                source.output >= (int)model.accessors.size()) {
+                continue;
+            }
+            if (!ReadAccessor(model, model.accessors[source.input], times, 1) ||
+                !ReadAccessor(model, model.accessors[source.output], values) || times.empty()) {
+                std::cerr << "Animacja " << clip.name << ": nie mozna odczytac samplera " << s << "\n";
+                continue;
+            }
+            AnimationSampler sampler;
+            sampler.interpolation = source.interpolation == "STEP"          ? Interpolation::Step
+                                    : source.interpolation == "CUBICSPLINE" ? Interpolation::CubicSpline
+                                                                            : Interpolation::Linear;
+            const size_t perKey = times.size() * (sampler.interpolation == Interpolation::CubicSpline ? 3 : 1);
+            if (values.size() % perKey != 0) {
+                std::cerr << "Animacja " << clip.name << ": sampler " << s << " ma niepasujaca liczbe wartosci\n";
+                continue;
+            }
+            // Specyfikacja wymaga rosnących czasów - naprawiamy, żeby kursor nie utknął
+            for (size_t k = 1; k < times.size(); ++k) times[k] = std::max(times[k], times[k - 1]);
+
+            sampler.firstTime = (uint32_t)clip.times.size();
+            sampler.keyCount = (uint32_t)times.size();
+            sampler.firstValue = (uint32_t)clip.values.size();
+            sampler.components = (uint32_t)(values.size() / perKey);
+            clip.times.insert(clip.times.end(), times.begin(), times.end());
+            clip.values.insert(clip.values.end(), values.begin(), values.end());
+            clip.start = std::min(clip.start, times.front());
+            clip.end = std::max(clip.end, times.back());
+            samplerMap[s] = (int)clip.samplers.size();
+            clip.samplers.push_back(sampler);
+        }
+
+        for (const auto& source : animation.channels) {
+            if (source.sampler < 0 || source.sampler >= (int)samplerMap.size() || samplerMap[source.sampler] < 0) continue;
+            if (source.target_node < 0 || source.target_node >= (int)model.nodes.size()) continue;
+            AnimationChannel channel;
+            channel.sampler = (uint32_t)samplerMap[source.sampler];
+            channel.node = source.target_node;
+            uint32_t expected;
+            if (source.target_path == "translation") {
+                channel.path = AnimationPath::Translation;
+                expected = 3;
+            } else if (source.target_path == "rotation") {
+                channel.path = AnimationPath::Rotation;
+                expected = 4;
+            } else if (source.target_path == "scale") {
+                channel.path = AnimationPath::Scale;
+                expected = 3;
+            } else if (source.target_path == "weights") {
+                channel.path = AnimationPath::Weights;
+                expected = NodeWeightCount(model, model.nodes[channel.node]);
+            } else {
+                std::cerr << "Animacja " << clip.name << ": nieobslugiwana sciezka " << source.target_path << "\n";
+                continue;
+            }
+            if (model.nodes[channel.node].matrix.size() == 16) {
+                std::cerr << "Animacja " << clip.name << ": wezel " << channel.node << " ma macierz - kanal pominiety\n";
+                continue;
+            }
+            if (expected == 0 || clip.samplers[channel.sampler].components != expected) {
+                std::cerr << "Animacja " << clip.name << ": kanal " << source.target_path << " wezla " << channel.node
+                          << " ma zla liczbe skladowych\n";
+                continue;
+            }
+            clip.channels.push_back(channel);
+        }
+
+        if (clip.channels.empty()) continue;
+        clips.push_back(std::move(clip));
+    }
+}
+
+namespace animation_detail {
+
+// Przesunięcie kursora do przedziału zawierającego t (t >= times[0])
+inline uint32_t AdvanceKey(const float* times, uint32_t count, uint32_t key, float t) {
+    if (t < times[key]) key = 0; // Czas się cofnął
+    while (key + 1 < count && times[key + 1] <= t) ++key;
+    return key;
+}
+
+// Slerp kwaternionów x, y, z, w po krótszym łuku; dla bliskich - znormalizowany lerp
+inline void Slerp(const float* a, const float* b, float u, float* out) {
+    float dot = a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3];
+    const float sign = dot < 0.0f ? -1.0f : 1.0f;
+    dot *= sign;
+    float wa, wb;
+    if (dot > 0.9995f) {
+        wa = 1.0f - u;
+        wb = u * sign;
+    } else {
+        const float angle = std::acos(dot);
+        const float inv = 1.0f / std::sin(angle);
+        wa = std::sin((1.0f - u) * angle) * inv;
+        wb = std::sin(u * angle) * inv * sign;
+    }
+    float length = 0.0f;
+    for (int i = 0; i < 4; ++i) {
+        out[i] = wa * a[i] + wb * b[i];
+        length += out[i] * out[i];
+    }
+    const float scale = length > 0.0f ? 1.0f / std::sqrt(length) : 0.0f;
+    for (int i = 0; i < 4; ++i) out[i] *= scale;
+}
+
+inline void Normalize4(float* q) {
+    const float length = std::sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+    const float scale = length > 0.0f ? 1.0f / length : 0.0f;
+    for (int i = 0; i < 4; ++i) q[i] *= scale;
+}
+
+}  // namespace animation_detail
+
+// --- Wartość samplera w chwili t (czas klipu); key - kursor samplera ---
+inline void SampleAnimation(const AnimationClip& clip, const AnimationSampler& sampler, uint32_t& key, float t,
+                            bool rotation, float* out) {
+    const float* times = clip.times.data() + sampler.firstTime;
+    const float* values = clip.values.data() + sampler.firstValue;
+    const uint32_t c = sampler.components;
+    const bool cubic = sampler.interpolation == Interpolation::CubicSpline;
+    const uint32_t stride = cubic ? 3 * c : c;
+    const uint32_t valueOffset = cubic ? c : 0; // Wartość leży między stycznymi
+
+    if (t <= times[0]) {
+        std::memcpy(out, values + valueOffset, c * sizeof(float));
+        return;
+    }
+    key = animation_detail::AdvanceKey(times, sampler.keyCount, key, t);
+    const float* v0 = values + (size_t)key * stride + valueOffset;
+    if (key + 1 >= sampler.keyCount || sampler.interpolation == Interpolation::Step) {
+        std::memcpy(out, v0, c * sizeof(float));
+        return;
+    }
+
+    const float dt = times[key + 1] - times[key];
+    const float u = dt > 0.0f ? (t - times[key]) / dt : 0.0f;
+    const float* v1 = v0 + stride;
+    if (!cubic) {
+        if (rotation) {
+            animation_detail::Slerp(v0, v1, u, out);
+            return;
+        }
+        for (uint32_t i = 0; i < c; ++i) out[i] = v0[i] + (v1[i] - v0[i]) * u;
+        return;
+    }
+
+    // Hermite: styczna wyjściowa klucza k i wejściowa k + 1, przeskalowane długością przedziału
+    const float u2 = u * u, u3 = u2 * u;
+    const float h00 = 2.0f * u3 - 3.0f * u2 + 1.0f, h10 = (u3 - 2.0f * u2 + u) * dt;
+    const float h01 = -2.0f * u3 + 3.0f * u2, h11 = (u3 - u2) * dt;
+    const float* outTangent = v0 + c;
+    const float* inTangent = v1 - c;
+    for (uint32_t i = 0; i < c; ++i) out[i] = h00 * v0[i] + h10 * outTangent[i] + h01 * v1[i] + h11 * inTangent[i];
+    if (rotation) animation_detail::Normalize4(out);
+}
+
+// --- Wszystkie kanały klipu w chwili t do pozy; węzły ze zmienionym TRS dostają changed = 1 ---
+inline void SampleClip(const AnimationClip& clip, float t, AnimationCursor& cursor, NodePose& pose) {
+    if (cursor.keys.size() != clip.samplers.size()) cursor.Reset(clip);
+    for (const AnimationChannel& channel : clip.channels) {
+        float* out;
+        switch (channel.path) {
+        case AnimationPath::Translation: out = &pose.translation[channel.node].x; break;
+        case AnimationPath::Rotation: out = &pose.rotation[channel.node].x; break;
+        case AnimationPath::Scale: out = &pose.scale[channel.node].x; break;
+        default: out = pose.weights.data() + pose.weightOffset[channel.node]; break;
+        }
+        SampleAnimation(clip, clip.samplers[channel.sampler], cursor.keys[channel.sampler], t,
+                        channel.path == AnimationPath::Rotation, out);
+        if (channel.path != AnimationPath::Weights) pose.changed[channel.node] = 1;
+    }
+}
+
+// --- Odtwarzanie jednego klipu w pętli ---
+struct AnimationPlayer {
+    int clip = 0;
+    double time = 0; // Sekundy od początku klipu
+    float speed = 1.0f;
+    bool loop = true;
+    AnimationCursor cursor;
+
+    void Play(int index) {
+        clip = index;
+        time = 0;
+        cursor.keys.clear();
+    }
+
+    // Krok czasu i próbkowanie aktywnego klipu; false, gdy nie ma czego odtwarzać
+    bool Advance(const std::vector<AnimationClip>& clips, double dtSeconds, NodePose& pose) {
+        if (clip < 0 || clip >= (int)clips.size()) return false;
+        const AnimationClip& active = clips[clip];
+        time += dtSeconds * speed;
+        const double duration = active.Duration();
+        double local = time;
+        if (duration <= 0.0) {
+            local = 0.0;
+        } else if (loop) {
+            time = std::fmod(time, duration); // Nie rośnie bez końca (precyzja float)
+            if (time < 0.0) time += duration;
+            local = time;
+        } else {
+            local = std::min(std::max(time, 0.0), duration);
+        }
+        SampleClip(active, active.start + (float)local, cursor, pose);
+        return true;
+    }
+};
+
+// --- Liczba kluczy wszystkich samplerów klipów (raport) ---
+inline size_t AnimationKeyCount(const std::vector<AnimationClip>& clips) {
+    size_t keys = 0;
+    for (const auto& clip : clips) keys += clip.times.size();
+    return keys;
+}
+
+#endif  // ANIMATION_H_
@@ -0,0 +1,239 @@
+// Składanie przeplecionych wierzchołków (pozycja, normalna, UV = 8 floatów)
+// z osobnych strumieni atrybutów glTF o dowolnym byteStride, z opcjonalną
+// transformacją pozycji/normalnych (batching statycznych meshy).
+//
+// Wersje: SSE2 (natywnie x86-64), WASM SIMD128 (Emscripten z -msimd128)
+// i skalarna - zawsze dostępna jako referencja dla benchmarku (bench_gather.cpp).
+// Brakujące atrybuty i transformacja są rozstrzygane raz na wywołanie
+// (parametry szablonu), a nie w pętli dla każdego wierzchołka.
+#ifndef ATTRIBUTE_GATHER_H_
+#define ATTRIBUTE_GATHER_H_
+
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define ATTRIBUTE_GATHER_SSE2 1
+#elif defined(__wasm_simd128__)
+#include <wasm_simd128.h>
+#define ATTRIBUTE_GATHER_WASM_SIMD 1
+#endif
+
+// Strumień jednego atrybutu; data == nullptr oznacza brak atrybutu (wypełniany zerami)
+struct AttributeStream {
+    const unsigned char* data = nullptr;
+    size_t stride = 0; // Bajty między kolejnymi elementami (Accessor::ByteStride)
+};
+
+// Transformacja opcjonalna: macierz 4x4 dla pozycji i 3x3 dla normalnych (kolumnowe, jak glm)
+struct GatherTransform {
+    const float* matrix = nullptr;       // 16 floatów albo nullptr = bez transformacji
+    const float* normalMatrix = nullptr; // 9 floatów
+};
+
+namespace gather_detail {
+
+inline void Load3(const unsigned char* p, float out[3]) { std::memcpy(out, p, 3 * sizeof(float)); }
+
+template <bool kNormal, bool kTexcoord, bool kTransform>
+inline void GatherOneScalar(float* dst, const unsigned char* pos, const unsigned char* nrm, const unsigned char* uv,
+                            const GatherTransform& xf) {
+    float p[3], n[3] = {0.0f, 0.0f, 0.0f}, t[2] = {0.0f, 0.0f};
+    Load3(pos, p);
+    if (kNormal) Load3(nrm, n);
+    if (kTexcoord) std::memcpy(t, uv, 2 * sizeof(float));
+
+    if (kTransform) {
+        const float* m = xf.matrix;
+        float tp[3];
+        for (int r = 0; r < 3; ++r) tp[r] = m[r] * p[0] + m[4 + r] * p[1] + m[8 + r] * p[2] + m[12 + r];
+        std::memcpy(p, tp, sizeof(tp));
+        if (kNormal) {
+            const float* nm = xf.normalMatrix;
+            float tn[3];
+            for (int r = 0; r < 3; ++r) tn[r] = nm[r] * n[0] + nm[3 + r] * n[1] + nm[6 + r] * n[2];
+            float len = std::sqrt(tn[0] * tn[0] + tn[1] * tn[1] + tn[2] * tn[2]);
+            float inv = (len > 0.0f) ? 1.0f / len : 0.0f;
+            for (int r = 0; r < 3; ++r) n[r] = tn[r] * inv;
+        }
+    }
+
+    dst[0] = p[0]; dst[1] = p[1]; dst[2] = p[2];
+    dst[3] = n[0]; dst[4] = n[1]; dst[5] = n[2];
+    dst[6] = t[0]; dst[7] = t[1];
+}
+
+template <bool kNormal, bool kTexcoord, bool kTransform>
+inline void GatherRangeScalar(float* dst, size_t begin, size_t end, const AttributeStream& position,
+                              const AttributeStream& normal, const AttributeStream& texcoord, const GatherTransform& xf) {
+    for (size_t i = begin; i < end; ++i) {
+        GatherOneScalar<kNormal, kTexcoord, kTransform>(
+            dst + i * 8, position.data + i * position.stride,
+            kNormal ? normal.data + i * normal.stride : nullptr,
+            kTexcoord ? texcoord.data + i * texcoord.stride : nullptr, xf);
+    }
+}
+
+#if defined(ATTRIBUTE_GATHER_SSE2)
+// Ładowanie 4 floatów czyta 4 bajty za vec3 - dlatego ostatni wierzchołek idzie ścieżką skalarną
+template <bool kNormal, bool kTexcoord, bool kTransform>
+inline void GatherRangeSimd(float* dst, size_t count, const AttributeStream& position,
+                            const AttributeStream& normal, const AttributeStream& texcoord, const GatherTransform& xf) {
+    __m128 c0, c1, c2, c3, n0, n1, n2;
+    if (kTransform) {
+        const float* m = xf.matrix;
+        c0 = _mm_loadu_ps(m); c1 = _mm_loadu_ps(m + 4); c2 = _mm_loadu_ps(m + 8); c3 = _mm_loadu_ps(m + 12);
+        const float* nm = xf.normalMatrix;
+        n0 = _mm_setr_ps(nm[0], nm[1], nm[2], 0.0f);
+        n1 = _mm_setr_ps(nm[3], nm[4], nm[5], 0.0f);
+        n2 = _mm_setr_ps(nm[6], nm[7], nm[8], 0.0f);
+    }
+
+    const unsigned char* pos = position.data;
+    const unsigned char* nrm = normal.data;
+    const unsigned char* uv = texcoord.data;
+    const size_t simdCount = count ? count - 1 : 0;
+
+    for (size_t i = 0; i < simdCount; ++i) {
+        __m128 p = _mm_loadu_ps(reinterpret_cast<const float*>(pos));
+        __m128 n = kNormal ? _mm_loadu_ps(reinterpret_cast<const float*>(nrm)) : _mm_setzero_ps();
+        __m128 t = kTexcoord ? _mm_castpd_ps(_mm_load_sd(reinterpret_cast<const double*>(uv))) : _mm_setzero_ps();
+
+        if (kTransform) {
+            p = _mm_add_ps(_mm_add_ps(_mm_mul_ps(c0, _mm_shuffle_ps(p, p, 0x00)), _mm_mul_ps(c1, _mm_shuffle_ps(p, p, 0x55))),
+                           _mm_add_ps(_mm_mul_ps(c2, _mm_shuffle_ps(p, p, 0xAA)), c3));
+            if (kNormal) {
+                n = _mm_add_ps(_mm_add_ps(_mm_mul_ps(n0, _mm_shuffle_ps(n, n, 0x00)), _mm_mul_ps(n1, _mm_shuffle_ps(n, n, 0x55))),
+                               _mm_mul_ps(n2, _mm_shuffle_ps(n, n, 0xAA)));
+                __m128 sq = _mm_mul_ps(n, n); // w = 0, więc suma 4 pasów = długość^2
+                sq = _mm_add_ps(sq, _mm_shuffle_ps(sq, sq, _MM_SHUFFLE(2, 3, 0, 1)));
+                sq = _mm_add_ps(sq, _mm_shuffle_ps(sq, sq, _MM_SHUFFLE(1, 0, 3, 2)));
+                __m128 len = _mm_sqrt_ps(sq);
+                __m128 nonZero = _mm_cmpgt_ps(len, _mm_setzero_ps());
+                n = _mm_and_ps(_mm_div_ps(n, len), nonZero);
+            }
+        }
+
+        // lo = [px py pz nx], hi = [ny nz u v]
+        __m128 zx = _mm_shuffle_ps(p, n, _MM_SHUFFLE(0, 0, 2, 2)); // [pz pz nx nx]
+        __m128 lo = _mm_shuffle_ps(p, zx, _MM_SHUFFLE(2, 0, 1, 0));
+        __m128 hi = _mm_shuffle_ps(n, t, _MM_SHUFFLE(1, 0, 2, 1));
+        _mm_storeu_ps(dst + i * 8, lo);
+        _mm_storeu_ps(dst + i * 8 + 4, hi);
+
+        pos += position.stride;
+        if (kNormal) nrm += normal.stride;
+        if (kTexcoord) uv += texcoord.stride;
+    }
+    GatherRangeScalar<kNormal, kTexcoord, kTransform>(dst, simdCount, count, position, normal, texcoord, xf);
+}
+#elif defined(ATTRIBUTE_GATHER_WASM_SIMD)
+template <bool kNormal, bool kTexcoord, bool kTransform>
+inline void GatherRangeSimd(float* dst, size_t count, const AttributeStream& position,
+                            const AttributeStream& normal, const AttributeStream& texcoord, const GatherTransform& xf) {
+    v128_t c0, c1, c2, c3, n0, n1, n2;
+    if (kTransform) {
+        const float* m = xf.matrix;
+        c0 = wasm_v128_load(m); c1 = wasm_v128_load(m + 4); c2 = wasm_v128_load(m + 8); c3 = wasm_v128_load(m + 12);
+        const float* nm = xf.normalMatrix;
+        n0 = wasm_f32x4_make(nm[0], nm[1], nm[2], 0.0f);
+        n1 = wasm_f32x4_make(nm[3], nm[4], nm[5], 0.0f);
+        n2 = wasm_f32x4_make(nm[6], nm[7], nm[8], 0.0f);
+    }
+
+    const unsigned char* pos = position.data;
+    const unsigned char* nrm = normal.data;
+    const unsigned char* uv = texcoord.data;
+    const size_t simdCount = count ? count - 1 : 0;
+
+    for (size_t i = 0; i < simdCount; ++i) {
+        v128_t p = wasm_v128_load(pos);
+        v128_t n = kNormal ? wasm_v128_load(nrm) : wasm_f32x4_splat(0.0f);
+        v128_t t = kTexcoord ? wasm_v128_load64_zero(uv) : wasm_f32x4_splat(0.0f);
+
+        if (kTransform) {
+            p = wasm_f32x4_add(wasm_f32x4_add(wasm_f32x4_mul(c0, wasm_i32x4_shuffle(p, p, 0, 0, 0, 0)),
+                                              wasm_f32x4_mul(c1, wasm_i32x4_shuffle(p, p, 1, 1, 1, 1))),
+                               wasm_f32x4_add(wasm_f32x4_mul(c2, wasm_i32x4_shuffle(p, p, 2, 2, 2, 2)), c3));
+            if (kNormal) {
+                n = wasm_f32x4_add(wasm_f32x4_add(wasm_f32x4_mul(n0, wasm_i32x4_shuffle(n, n, 0, 0, 0, 0)),
+                                                  wasm_f32x4_mul(n1, wasm_i32x4_shuffle(n, n, 1, 1, 1, 1))),
+                                   wasm_f32x4_mul(n2, wasm_i32x4_shuffle(n, n, 2, 2, 2, 2)));
+                v128_t sq = wasm_f32x4_mul(n, n);
+                sq = wasm_f32x4_add(sq, wasm_i32x4_shuffle(sq, sq, 1, 0, 3, 2));
+                sq = wasm_f32x4_add(sq, wasm_i32x4_shuffle(sq, sq, 2, 3, 0, 1));
+                v128_t len = wasm_f32x4_sqrt(sq);
+                v128_t nonZero = wasm_f32x4_gt(len, wasm_f32x4_splat(0.0f));
+                n = wasm_v128_and(wasm_f32x4_div(n, len), nonZero);
+            }
+        }
+
+        wasm_v128_store(dst + i * 8, wasm_i32x4_shuffle(p, n, 0, 1, 2, 4));
+        wasm_v128_store(dst + i * 8 + 4, wasm_i32x4_shuffle(n, t, 1, 2, 4, 5));
+
+        pos += position.stride;
+        if (kNormal) nrm += normal.stride;
+        if (kTexcoord) uv += texcoord.stride;
+    }
+    GatherRangeScalar<kNormal, kTexcoord, kTransform>(dst, simdCount, count, position, normal, texcoord, xf);
+}
+#endif
+
+template <bool kNormal, bool kTexcoord, bool kTransform>
+inline void GatherDispatch(float* dst, size_t count, const AttributeStream& position, const AttributeStream& normal,
+                           const AttributeStream& texcoord, const GatherTransform& xf, bool simd) {
+#if defined(ATTRIBUTE_GATHER_SSE2) || defined(ATTRIBUTE_GATHER_WASM_SIMD)
+    if (simd) {
+        GatherRangeSimd<kNormal, kTexcoord, kTransform>(dst, count, position, normal, texcoord, xf);
+        return;
+    }
+#endif
+    (void)simd;
+    GatherRangeScalar<kNormal, kTexcoord, kTransform>(dst, 0, count, position, normal, texcoord, xf);
+}
+
+inline void Gather(float* dst, size_t count, const AttributeStream& position, const AttributeStream& normal,
+                   const AttributeStream& texcoord, const GatherTransform& xf, bool simd) {
+    const int variant = (normal.data ? 1 : 0) | (texcoord.data ? 2 : 0) | (xf.matrix ? 4 : 0);
+    switch (variant) {
+    case 0: GatherDispatch<false, false, false>(dst, count, position, normal, texcoord, xf, simd); break;
+    case 1: GatherDispatch<true, false, false>(dst, count, position, normal, texcoord, xf, simd); break;
+    case 2: GatherDispatch<false, true, false>(dst, count, position, normal, texcoord, xf, simd); break;
+    case 3: GatherDispatch<true, true, false>(dst, count, position, normal, texcoord, xf, simd); break;
+    case 4: GatherDispatch<false, false, true>(dst, count, position, normal, texcoord, xf, simd); break;
+    case 5: GatherDispatch<true, false, true>(dst, count, position, normal, texcoord, xf, simd); break;
+    case 6: GatherDispatch<false, true, true>(dst, count, position, normal, texcoord, xf, simd); break;
+    default: GatherDispatch<true, true, true>(dst, count, position, normal, texcoord, xf, simd); break;
+    }
+}
+
+}  // namespace gather_detail
+
+// --- Wierzchołki [pos.xyz, normal.xyz, uv.xy] do dst (8 floatów na wierzchołek) ---
+inline void GatherVertices(float* dst, size_t count, const AttributeStream& position, const AttributeStream& normal,
+                           const AttributeStream& texcoord, const GatherTransform& transform = GatherTransform()) {
+    gather_detail::Gather(dst, count, position, normal, texcoord, transform, true);
+}
+
+// --- To samo bez SIMD (referencja i porównanie w benchmarku) ---
+inline void GatherVerticesScalar(float* dst, size_t count, const AttributeStream& position, const AttributeStream& normal,
+                                 const AttributeStream& texcoord, const GatherTransform& transform = GatherTransform()) {
+    gather_detail::Gather(dst, count, position, normal, texcoord, transform, false);
+}
+
+// Nazwa aktywnego wariantu SIMD (do wypisania w benchmarku)
+inline const char* GatherSimdName() {
+#if defined(ATTRIBUTE_GATHER_SSE2) && defined(__AVX__)
+    return "SSE2 (kodowanie VEX, -mavx)";
+#elif defined(ATTRIBUTE_GATHER_SSE2)
+    return "SSE2";
+#elif defined(ATTRIBUTE_GATHER_WASM_SIMD)
+    return "WASM SIMD128";
+#else
+    return "brak (skalarnie)";
+#endif
+}
+
+#endif  // ATTRIBUTE_GATHER_H_
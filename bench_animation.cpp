@@ -0,0 +1,275 @@
+// Benchmark próbkowania animacji z animation.h: kursor przesuwany do przodu
+// (SampleClip) kontra wyszukiwanie binarne przedziału kluczy w każdej klatce.
+// Syntetyczny klip: N kanałów (po kolei translation / rotation / scale, każdy
+// z własnym samplerem), interpolacje LINEAR / STEP / CUBICSPLINE na zmianę,
+// odtwarzany w pętli krokiem 1/60 s. Wyniki obu metod są porównywane.
+// Dodatkowo klipy z plików GLB: czas konwersji (ExtractAnimations) i próbkowania.
+// Morph targety z morph.h: syntetyczny mesh z wieloma lokalnymi targetami, z których
+// kilka zmienia wagę co klatkę - rzadkie delty i zakres zmian (SIMD / skalarnie)
+// kontra gęsta suma wszystkich targetów dla całego meshu.
+//
+// Budowa (Linux, json.hpp z repozytorium tinygltf):
+//   g++ -O2 -std=c++17 -pthread bench_animation.cpp tiny_gltf.cc -Itinygltf -o bench_animation
+// Użycie:
+//   ./bench_animation [kanaly] [klatki] [plik.glb ...]
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "animation.h"
+#include "morph.h"
+#include "tiny_gltf.h"
+
+static double MsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Klip z `channels` kanałami po `keys` kluczy, klucze co 1/30 s z lekkim rozrzutem
+static AnimationClip MakeClip(size_t channels, uint32_t keys) {
+    AnimationClip clip;
+    clip.name = "syntetyczny";
+    uint32_t seed = 12345;
+    auto random = [&] {
+        seed = seed * 1664525u + 1013904223u;
+        return (seed >> 8) / 16777216.0f;
+    };
+    for (size_t c = 0; c < channels; ++c) {
+        AnimationSampler sampler;
+        const AnimationPath path = (AnimationPath)(c % 3);
+        sampler.components = (path == AnimationPath::Rotation) ? 4 : 3;
+        sampler.interpolation = (Interpolation)((c / 3) % 3);
+        sampler.firstTime = (uint32_t)clip.times.size();
+        sampler.keyCount = keys;
+        sampler.firstValue = (uint32_t)clip.values.size();
+        float t = 0.0f;
+        for (uint32_t k = 0; k < keys; ++k) {
+            clip.times.push_back(t);
+            t += (0.5f + random()) / 30.0f;
+            const int parts = (sampler.interpolation == Interpolation::CubicSpline) ? 3 : 1;
+            for (int part = 0; part < parts; ++part) {
+                float value[4];
+                for (float& v : value) v = random() * 2.0f - 1.0f;
+                if (path == AnimationPath::Rotation && part == parts / 2) animation_detail::Normalize4(value);
+                clip.values.insert(clip.values.end(), value, value + sampler.components);
+            }
+        }
+        clip.end = std::max(clip.end, clip.times.back());
+        clip.samplers.push_back(sampler);
+
+        AnimationChannel channel;
+        channel.sampler = (uint32_t)c;
+        channel.node = (int)(c / 3);
+        channel.path = path;
+        clip.channels.push_back(channel);
+    }
+    return clip;
+}
+
+static NodePose MakePose(size_t nodes) {
+    NodePose pose;
+    pose.translation.assign(nodes, glm::vec3(0.0f));
+    pose.rotation.assign(nodes, glm::vec4(0.0f, 0.0f, 0.0f, 1.0f));
+    pose.scale.assign(nodes, glm::vec3(1.0f));
+    pose.weightOffset.assign(nodes + 1, 0);
+    pose.matrix.assign(nodes, 0);
+    pose.changed.assign(nodes, 0);
+    return pose;
+}
+
+// Dawne podejście: przedział kluczy szukany od zera w każdej klatce (std::upper_bound)
+static void SampleClipBinarySearch(const AnimationClip& clip, float t, NodePose& pose) {
+    for (const AnimationChannel& channel : clip.channels) {
+        const AnimationSampler& sampler = clip.samplers[channel.sampler];
+        const float* times = clip.times.data() + sampler.firstTime;
+        const float* found = std::upper_bound(times, times + sampler.keyCount, t);
+        uint32_t key = (found == times) ? 0 : (uint32_t)(found - times - 1);
+        float* out = (channel.path == AnimationPath::Translation) ? &pose.translation[channel.node].x
+                     : (channel.path == AnimationPath::Rotation)  ? &pose.rotation[channel.node].x
+                                                                   : &pose.scale[channel.node].x;
+        SampleAnimation(clip, sampler, key, t, channel.path == AnimationPath::Rotation, out);
+        pose.changed[channel.node] = 1;
+    }
+}
+
+static float MaxPoseDiff(const NodePose& a, const NodePose& b) {
+    float diff = 0.0f;
+    for (size_t i = 0; i < a.Size(); ++i) {
+        for (int c = 0; c < 3; ++c) {
+            diff = std::max(diff, std::abs(a.translation[i][c] - b.translation[i][c]));
+            diff = std::max(diff, std::abs(a.scale[i][c] - b.scale[i][c]));
+        }
+        for (int c = 0; c < 4; ++c) diff = std::max(diff, std::abs(a.rotation[i][c] - b.rotation[i][c]));
+    }
+    return diff;
+}
+
+// Mesh `vertices` wierzchołków i `targets` targetów, każdy przesuwa ciągły fragment ~2% wierzchołków
+static MorphMesh MakeMorphMesh(uint32_t vertices, size_t targets) {
+    MorphMesh morph;
+    uint32_t seed = 777;
+    auto random = [&] {
+        seed = seed * 1664525u + 1013904223u;
+        return (seed >> 8) / 16777216.0f;
+    };
+    morph.base.resize((size_t)vertices * 8);
+    for (float& v : morph.base) v = random();
+    const uint32_t span = std::max(1u, vertices / 50);
+    for (size_t t = 0; t < targets; ++t) {
+        MorphTarget target;
+        const uint32_t first = (uint32_t)(random() * (vertices - span));
+        for (uint32_t v = first; v < first + span; ++v) {
+            target.vertices.push_back(v);
+            for (int c = 0; c < 8; ++c) target.deltas.push_back((c == 3 || c == 6 || c == 7) ? 0.0f : random() - 0.5f);
+        }
+        target.first = target.vertices.front();
+        target.last = target.vertices.back();
+        morph.targets.push_back(std::move(target));
+    }
+    return morph;
+}
+
+// Dawne podejście: gęste delty (0 dla nieruszanych wierzchołków), cały mesh przeliczany co klatkę
+static void EvaluateMorphDense(const MorphMesh& morph, const std::vector<std::vector<float>>& dense, const float* weights,
+                               std::vector<float>& out) {
+    out = morph.base;
+    for (size_t t = 0; t < dense.size(); ++t) {
+        if (weights[t] == 0.0f) continue;
+        for (size_t i = 0; i < out.size(); ++i) out[i] += weights[t] * dense[t][i];
+    }
+}
+
+static void BenchMorph(int frames, bool& ok) {
+    const uint32_t vertices = 50000;
+    const size_t targetCount = 64, animatedCount = 4;
+    MorphMesh simd = MakeMorphMesh(vertices, targetCount), scalar = simd;
+    std::vector<std::vector<float>> dense(targetCount, std::vector<float>((size_t)vertices * 8, 0.0f));
+    for (size_t t = 0; t < targetCount; ++t) {
+        const MorphTarget& target = simd.targets[t];
+        for (size_t i = 0; i < target.vertices.size(); ++i) {
+            std::copy_n(target.deltas.data() + i * 8, 8, dense[t].data() + (size_t)target.vertices[i] * 8);
+        }
+    }
+
+    // Połowa targetów ze stałą wagą, pierwsze animatedCount zmieniają się co klatkę
+    std::vector<float> weights(targetCount, 0.0f), reference;
+    for (size_t t = animatedCount; t < targetCount; t += 2) weights[t] = 0.5f;
+    double denseMs = 0.0, simdMs = 0.0, scalarMs = 0.0;
+    uint64_t uploaded = 0;
+    float maxDiff = 0.0f;
+    for (int frame = 0; frame < frames; ++frame) {
+        for (size_t t = 0; t < animatedCount; ++t) weights[t] = 0.5f + 0.5f * std::sin(frame * 0.05f + (float)t);
+        auto start = std::chrono::steady_clock::now();
+        EvaluateMorphDense(simd, dense, weights.data(), reference);
+        denseMs += MsSince(start);
+
+        uint32_t begin, end;
+        start = std::chrono::steady_clock::now();
+        if (EvaluateMorph<true>(simd, weights.data(), weights.size(), begin, end)) uploaded += end - begin;
+        simdMs += MsSince(start);
+
+        start = std::chrono::steady_clock::now();
+        EvaluateMorph<false>(scalar, weights.data(), weights.size(), begin, end);
+        scalarMs += MsSince(start);
+
+        for (size_t i = 0; i < reference.size(); ++i) {
+            const float diff = std::max(std::abs(simd.current[i] - reference[i]), std::abs(scalar.current[i] - reference[i]));
+            maxDiff = std::max(maxDiff, diff);
+        }
+    }
+    if (maxDiff > 1e-4f) ok = false;
+
+    std::cout << "\nMorph: " << vertices << " wierzcholkow, " << targetCount << " targetow (po " << vertices / 50
+              << " delt), " << animatedCount << " animowane\n"
+              << std::fixed << std::setprecision(3) << "  geste delty:       " << denseMs / frames << " ms/klatke\n"
+              << "  rzadkie, skalarne: " << scalarMs / frames << " ms/klatke\n"
+              << "  rzadkie, SIMD:     " << simdMs / frames << " ms/klatke (x" << std::setprecision(1) << denseMs / simdMs
+              << " wzgledem gestych)\n"
+              << "  glBufferSubData: " << 100.0 * uploaded / ((double)frames * vertices)
+              << "% wierzcholkow na klatke, max roznica " << std::scientific << maxDiff << "\n";
+    std::cout.unsetf(std::ios_base::floatfield);
+}
+
+int main(int argc, char** argv) {
+    size_t channels = (argc > 1) ? (size_t)std::max(1, std::atoi(argv[1])) : 6000;
+    int frames = (argc > 2) ? std::max(1, std::atoi(argv[2])) : 1000;
+    std::vector<std::string> files;
+    for (int i = 3; i < argc; ++i) files.push_back(argv[i]);
+    if (files.empty()) files.push_back("asserts/earth_globe_hologram_2mb_looping_animation.glb");
+
+    const double dt = 1.0 / 60.0;
+    std::cout << "\n" << channels << " kanalow, " << frames << " klatek co 1/60 s (w petli)\n";
+    std::cout << std::left << std::setw(10) << "klucze" << std::right << std::setw(14) << "kursor [ms]" << std::setw(14)
+              << "binarne [ms]" << std::setw(12) << "ns/kanal" << std::setw(10) << "x binarne" << std::setw(13)
+              << "max roznica" << "\n";
+
+    bool ok = true;
+    for (uint32_t keys : {30u, 300u, 3000u}) {
+        const AnimationClip clip = MakeClip(channels, keys);
+        const std::vector<AnimationClip> clips(1, clip);
+        NodePose cursorPose = MakePose(channels / 3 + 1), searchPose = cursorPose;
+
+        AnimationPlayer player;
+        float maxDiff = 0.0f;
+        double cursorMs = 0.0, searchMs = 0.0;
+        for (int frame = 0; frame < frames; ++frame) {
+            auto start = std::chrono::steady_clock::now();
+            player.Advance(clips, frame == 0 ? 0.0 : dt, cursorPose);
+            cursorMs += MsSince(start);
+
+            start = std::chrono::steady_clock::now();
+            SampleClipBinarySearch(clip, clip.start + (float)player.time, searchPose);
+            searchMs += MsSince(start);
+            maxDiff = std::max(maxDiff, MaxPoseDiff(cursorPose, searchPose));
+        }
+        if (maxDiff > 1e-6f) ok = false;
+
+        std::cout << std::left << std::setw(10) << keys << std::right << std::fixed << std::setprecision(3) << std::setw(14)
+                  << cursorMs / frames << std::setw(14) << searchMs / frames << std::setprecision(1) << std::setw(12)
+                  << cursorMs * 1e6 / ((double)frames * channels) << std::setw(10) << searchMs / cursorMs << std::setw(13)
+                  << std::scientific << std::setprecision(1) << maxDiff << "\n";
+        std::cout.unsetf(std::ios_base::floatfield);
+    }
+
+    BenchMorph(std::min(frames, 300), ok);
+
+    for (const std::string& file : files) {
+        tinygltf::Model model;
+        tinygltf::TinyGLTF loader;
+        loader.SetImagesAsIs(true);
+        std::string err, warn;
+        if (!loader.LoadBinaryFromFile(&model, &err, &warn, file)) {
+            std::cerr << "Nie udalo sie wczytac " << file << ": " << err << std::endl;
+            continue;
+        }
+        auto start = std::chrono::steady_clock::now();
+        std::vector<AnimationClip> clips;
+        ExtractAnimations(model, clips);
+        const double extractMs = MsSince(start);
+        std::cout << "\n" << file << ": " << clips.size() << " klipow, " << AnimationKeyCount(clips)
+                  << " kluczy, konwersja " << std::fixed << std::setprecision(3) << extractMs << " ms\n";
+        for (size_t c = 0; c < clips.size(); ++c) {
+            NodePose pose;
+            InitNodePose(model, pose);
+            AnimationPlayer player;
+            player.Play((int)c);
+            start = std::chrono::steady_clock::now();
+            for (int frame = 0; frame < frames; ++frame) player.Advance(clips, dt, pose);
+            const double ms = MsSince(start);
+            std::cout << "  " << clips[c].name << ": " << clips[c].channels.size() << " kanalow, "
+                      << std::setprecision(2) << clips[c].Duration() << " s, " << std::setprecision(1)
+                      << ms * 1e6 / ((double)frames * clips[c].channels.size()) << " ns/kanal\n";
+        }
+        std::cout.unsetf(std::ios_base::floatfield);
+    }
+
+    if (!ok) {
+        std::cerr << "Wyniki kursora lub morph targetow roznia sie od referencji!\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,185 @@
+// Mikrobenchmark składania wierzchołków z attribute_gather.h: dawna pętla
+// z renderer.h (glm, warunki w pętli, tylko ciasno upakowane atrybuty),
+// GatherVerticesScalar i GatherVertices (SSE2 / WASM SIMD128). Układy
+// źródłowe: osobne ciasne bufferView, jeden przepleciony (byteStride 32),
+// brak normalnych/UV i transformacja jak przy batchingu. Wyniki SIMD są
+// porównywane ze skalarną referencją.
+//
+// Budowa (Linux):
+//   g++ -O2 -std=c++17 bench_gather.cpp -o bench_gather
+// Użycie:
+//   ./bench_gather [wierzcholki] [powtorzenia]
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "attribute_gather.h"
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+struct Vertex {
+    glm::vec3 position;
+    glm::vec3 normal;
+    glm::vec2 texcoord;
+};
+
+// Dane źródłowe w dwóch układach: osobne tablice i przeplecione (pos, normal, uv)
+struct SourceData {
+    std::vector<float> positions, normals, texcoords;
+    std::vector<float> interleaved;
+};
+
+static SourceData MakeSource(size_t count) {
+    SourceData s;
+    s.positions.resize(count * 3);
+    s.normals.resize(count * 3);
+    s.texcoords.resize(count * 2);
+    s.interleaved.resize(count * 8);
+    for (size_t i = 0; i < count; ++i) {
+        float a = 0.001f * i;
+        float p[3] = {std::cos(a) * 3.0f, std::sin(a * 0.7f) * 2.0f, 0.01f * (i % 1000)};
+        float n[3] = {std::cos(a), std::sin(a), 0.0f};
+        float t[2] = {0.5f + 0.5f * std::cos(a), 0.5f + 0.5f * std::sin(a)};
+        std::memcpy(&s.positions[i * 3], p, sizeof(p));
+        std::memcpy(&s.normals[i * 3], n, sizeof(n));
+        std::memcpy(&s.texcoords[i * 2], t, sizeof(t));
+        std::memcpy(&s.interleaved[i * 8], p, sizeof(p));
+        std::memcpy(&s.interleaved[i * 8 + 3], n, sizeof(n));
+        std::memcpy(&s.interleaved[i * 8 + 6], t, sizeof(t));
+    }
+    return s;
+}
+
+static AttributeStream Stream(const float* data, size_t stride) {
+    AttributeStream s;
+    s.data = reinterpret_cast<const unsigned char*>(data);
+    s.stride = stride;
+    return s;
+}
+
+// Pętla sprzed attribute_gather.h (z AppendPrimitive)
+static void LegacyGather(Vertex* out, size_t count, const float* positions, const float* normals,
+                         const float* texcoords, const glm::mat4& transform) {
+    const bool identity = (transform == glm::mat4(1.0f));
+    const glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3(transform)));
+    for (size_t i = 0; i < count; ++i) {
+        Vertex& v = out[i];
+        v.position = glm::vec3(positions[i * 3 + 0], positions[i * 3 + 1], positions[i * 3 + 2]);
+        if (normals) {
+            v.normal = glm::vec3(normals[i * 3 + 0], normals[i * 3 + 1], normals[i * 3 + 2]);
+        } else {
+            v.normal = glm::vec3(0.0f, 0.0f, 0.0f);
+        }
+        if (texcoords) {
+            v.texcoord = glm::vec2(texcoords[i * 2 + 0], texcoords[i * 2 + 1]);
+        } else {
+            v.texcoord = glm::vec2(0.0f, 0.0f);
+        }
+        if (!identity) {
+            v.position = glm::vec3(transform * glm::vec4(v.position, 1.0f));
+            if (normals) v.normal = glm::normalize(normalMatrix * v.normal);
+        }
+    }
+}
+
+// --- Najlepszy czas (ms) z kilku powtórzeń ---
+template <typename Fn>
+static double BestMs(int repeats, Fn fn) {
+    double best = 1e30;
+    for (int r = 0; r < repeats; ++r) {
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        best = std::min(best, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+    }
+    return best;
+}
+
+static float MaxDiff(const std::vector<Vertex>& a, const std::vector<Vertex>& b) {
+    const float* fa = reinterpret_cast<const float*>(a.data());
+    const float* fb = reinterpret_cast<const float*>(b.data());
+    float diff = 0.0f;
+    for (size_t i = 0; i < a.size() * 8; ++i) diff = std::max(diff, std::fabs(fa[i] - fb[i]));
+    return diff;
+}
+
+int main(int argc, char** argv) {
+    size_t count = (argc > 1) ? (size_t)std::max(1, std::atoi(argv[1])) : 2000000;
+    int repeats = (argc > 2) ? std::max(1, std::atoi(argv[2])) : 10;
+
+    SourceData src = MakeSource(count);
+    const glm::mat4 identity(1.0f);
+    const glm::mat4 transform = glm::scale(glm::rotate(glm::translate(glm::mat4(1.0f), glm::vec3(1, 2, 3)), 0.7f,
+                                                       glm::vec3(0, 1, 0)), glm::vec3(2.0f, 1.0f, 0.5f));
+    const glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3(transform)));
+    GatherTransform xf;
+    xf.matrix = glm::value_ptr(transform);
+    xf.normalMatrix = glm::value_ptr(normalMatrix);
+
+    const size_t tight3 = 3 * sizeof(float), tight2 = 2 * sizeof(float), inter = 8 * sizeof(float);
+    const AttributeStream none;
+
+    struct Case {
+        std::string name;
+        AttributeStream pos, nrm, uv;
+        GatherTransform xf;
+        bool legacy; // Dawna pętla obsługuje tylko ciasno upakowane atrybuty
+        const float* legacyNormals;
+        const float* legacyTexcoords;
+        const glm::mat4* legacyTransform;
+    };
+    std::vector<Case> cases = {
+        {"osobne, ciasne", Stream(src.positions.data(), tight3), Stream(src.normals.data(), tight3),
+         Stream(src.texcoords.data(), tight2), GatherTransform(), true, src.normals.data(), src.texcoords.data(), &identity},
+        {"przeplecione (stride 32)", Stream(src.interleaved.data(), inter), Stream(src.interleaved.data() + 3, inter),
+         Stream(src.interleaved.data() + 6, inter), GatherTransform(), false, nullptr, nullptr, &identity},
+        {"tylko POSITION", Stream(src.positions.data(), tight3), none, none, GatherTransform(), true, nullptr, nullptr,
+         &identity},
+        {"ciasne + transformacja", Stream(src.positions.data(), tight3), Stream(src.normals.data(), tight3),
+         Stream(src.texcoords.data(), tight2), xf, true, src.normals.data(), src.texcoords.data(), &transform},
+        {"przepl. + transformacja", Stream(src.interleaved.data(), inter), Stream(src.interleaved.data() + 3, inter),
+         Stream(src.interleaved.data() + 6, inter), xf, false, nullptr, nullptr, &transform},
+    };
+
+    std::vector<Vertex> reference(count), simd(count), legacy(count);
+
+    std::cout << "\n" << count << " wierzcholkow, najlepszy z " << repeats << " powtorzen, SIMD: " << GatherSimdName() << "\n";
+    std::cout << std::left << std::setw(26) << "uklad" << std::right << std::setw(12) << "stara [ms]"
+              << std::setw(12) << "skalar [ms]" << std::setw(12) << "SIMD [ms]" << std::setw(10) << "x skalar"
+              << std::setw(12) << "max roznica" << "\n";
+
+    bool ok = true;
+    for (const Case& c : cases) {
+        float* refOut = reinterpret_cast<float*>(reference.data());
+        float* simdOut = reinterpret_cast<float*>(simd.data());
+        double scalarMs = BestMs(repeats, [&] { GatherVerticesScalar(refOut, count, c.pos, c.nrm, c.uv, c.xf); });
+        double simdMs = BestMs(repeats, [&] { GatherVertices(simdOut, count, c.pos, c.nrm, c.uv, c.xf); });
+        float diff = MaxDiff(reference, simd);
+        if (diff > 1e-5f) ok = false;
+
+        std::cout << std::left << std::setw(26) << c.name << std::right << std::fixed << std::setprecision(2);
+        if (c.legacy) {
+            double legacyMs = BestMs(repeats, [&] {
+                LegacyGather(legacy.data(), count, src.positions.data(), c.legacyNormals, c.legacyTexcoords, *c.legacyTransform);
+            });
+            if (MaxDiff(reference, legacy) > 1e-5f) ok = false;
+            std::cout << std::setw(12) << legacyMs;
+        } else {
+            std::cout << std::setw(12) << "-";
+        }
+        std::cout << std::setw(12) << scalarMs << std::setw(12) << simdMs << std::setw(10) << scalarMs / simdMs
+                  << std::setw(12) << std::scientific << std::setprecision(1) << diff << "\n";
+    }
+
+    if (!ok) {
+        std::cerr << "Wyniki SIMD / dawnej petli roznia sie od referencji!\n";
+        return 1;
+    }
+    return 0;
+}
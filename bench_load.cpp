@@ -0,0 +1,75 @@
+// Benchmark ładowania GLB: czas LoadBinaryFromFile w zależności od liczby
+// wątków dekodujących obrazy (TinyGLTF::SetImageDecodeThreads).
+//
+// Budowa natywna (json.hpp / stb_image_write.h z repozytorium tinygltf):
+//   g++ -O2 -std=c++17 -pthread bench_load.cpp tiny_gltf.cc -Itinygltf -o bench_load
+// Użycie:
+//   ./bench_load [powtorzenia] [plik.glb ...]
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "tiny_gltf.h"
+
+static double LoadOnceMs(const std::string& path, int threads) {
+    tinygltf::Model model;
+    tinygltf::TinyGLTF loader;
+    loader.SetMemoryMapBinary(true);
+    loader.SetImageDecodeThreads(threads);
+    std::string err, warn;
+
+    auto start = std::chrono::steady_clock::now();
+    bool ok = loader.LoadBinaryFromFile(&model, &err, &warn, path);
+    auto end = std::chrono::steady_clock::now();
+
+    if (!ok) {
+        std::cerr << "Failed to load model: " << path << ": " << err << std::endl;
+        std::exit(1);
+    }
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+int main(int argc, char** argv) {
+    int repeats = (argc > 1) ? std::max(1, std::atoi(argv[1])) : 5;
+
+    std::vector<std::string> files;
+    for (int i = 2; i < argc; ++i) files.push_back(argv[i]);
+    if (files.empty()) {
+        files.push_back("asserts/earth_globe_hologram_2mb_looping_animation.glb");
+        files.push_back("asserts/el.glb");
+    }
+
+    // 1, 2, 4, ... aż do liczby rdzeni (co najmniej 4, żeby było widać nasycenie)
+    int maxThreads = std::max(4, (int)std::thread::hardware_concurrency());
+    std::vector<int> threadCounts;
+    for (int t = 1; t <= maxThreads; t *= 2) threadCounts.push_back(t);
+
+    std::cout << "Rdzenie: " << std::thread::hardware_concurrency()
+              << ", powtorzenia: " << repeats << " (mediana)\n";
+
+    for (const auto& file : files) {
+        std::cout << "\n" << file << "\n";
+        std::cout << std::setw(8) << "watki" << std::setw(12) << "ms" << std::setw(10) << "x\n";
+
+        double baseline = 0.0;
+        for (int threads : threadCounts) {
+            LoadOnceMs(file, threads); // rozgrzewka (cache plików)
+
+            std::vector<double> samples;
+            for (int r = 0; r < repeats; ++r) samples.push_back(LoadOnceMs(file, threads));
+            std::sort(samples.begin(), samples.end());
+            double median = samples[samples.size() / 2];
+            if (threads == 1) baseline = median;
+
+            std::cout << std::setw(8) << threads
+                      << std::setw(12) << std::fixed << std::setprecision(2) << median
+                      << std::setw(9) << std::setprecision(2) << baseline / median << "\n";
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,205 @@
+// Natywny benchmark ścieżki ładowania i renderowania (renderer.h) bez okna:
+// kontekst GLES2 na powierzchni pbuffer EGL (np. Mesa llvmpipe, platforma surfaceless).
+// Dla każdego pliku GLB mierzy parsowanie, dekodowanie obrazu, upload na GPU
+// i liczbę klatek na sekundę w N klatkach tej samej funkcji RenderFrame co przeglądarka.
+//
+// Budowa (Linux, json.hpp / stb_image_write.h z repozytorium tinygltf):
+//   g++ -O2 -std=c++17 -pthread bench_render.cpp tiny_gltf.cc -Itinygltf -lEGL -lGLESv2 -o bench_render
+// Użycie:
+//   ./bench_render [--no-batch] [--no-instancing] [--quantize] [--no-direct] [--discard] [--no-mipmaps] [--no-compressed] [--no-culling] [--stages] [--trace plik.json] [--load-trace katalog] [klatki] [plik.glb ...]
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "headless_egl.h"
+#include "renderer.h"
+
+static const int kWidth = 800;
+static const int kHeight = 600;
+
+static double MsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+struct BenchResult {
+    std::string file;
+    double parseMs = 0, decodeMs = 0, uploadMs = 0, frameMs = 0, fps = 0;
+    double glIssued = 0, glSkipped = 0; // Wywołania bind/use/uniform na klatkę (GLStateCache)
+    size_t draws = 0; // glDrawElements* na klatkę
+    int mipmapFrames = 0; // Klatki rozgrzewki do wgrania wszystkich poziomów mipmap
+    double mipmapMs = 0;
+    // Dane CPU gltfModel i sterta w użyciu: szczyt ładowania / po pierwszej klatce. Natywnie
+    // sterta obejmuje też pamięć sterownika (llvmpipe trzyma tekstury w pamięci procesu).
+    double modelMb = 0, modelSteadyMb = 0, heapPeakMb = 0, heapSteadyMb = 0;
+    double textureMb = 0; // Szacowana pamięć GPU tekstur (RGBA8 z mipmapami albo S3TC / ETC1)
+    // Percentyle czasu CPU klatki z frameStats (ostatnie FrameStats::kWindow), mediana GPU (-1 = brak zapytań)
+    double frameP95 = 0, frameP99 = 0, gpuMs = -1;
+    unsigned long long triangles = 0;
+    double visible = 0, culled = 0; // Obiekty (meshe / instancje) na klatkę po frustum cullingu
+};
+
+static bool BenchFile(const std::string& path, int frames, const std::string& loadTraceDir, BenchResult& result) {
+    result.file = path;
+
+    auto start = std::chrono::steady_clock::now();
+    if (!LoadGLB(path)) return false;
+    result.parseMs = MsSince(start);
+
+    // Geometria
+    start = std::chrono::steady_clock::now();
+    if (!LoadModelToOpenGL(gltfModel, myModel)) return false;
+    glFinish();
+    result.uploadMs = MsSince(start);
+    result.draws = CountDrawCalls(myModel);
+    result.modelMb = ModelCPUBytes(gltfModel) / (1024.0 * 1024.0);
+    if (discardAfterUpload) ReleaseModelBuffers(gltfModel);
+
+    // Tekstury - LoadPendingTextures jak w pierwszej klatce RenderFrame, z osobnym czasem dekodowania i uploadu
+    TextureLoadTimings timings;
+    LoadPendingTextures(gltfModel, myModel, &timings);
+    result.decodeMs += timings.decodeMs;
+    result.uploadMs += timings.uploadMs;
+    result.textureMb = textureGpuBytes / (1024.0 * 1024.0);
+    if (discardAfterUpload) ReleaseModelImages(gltfModel);
+
+    // Rozgrzewka (kompilacja shaderów w sterowniku, pierwsze użycie buforów) i dokończenie mipmap -
+    // mierzymy, po ilu klatkach i ms wszystkie tekstury mają pełny łańcuch
+    start = std::chrono::steady_clock::now();
+    do {
+        RenderFrame(kWidth, kHeight);
+        glFinish();
+        ++result.mipmapFrames;
+    } while (MipmapsPending());
+    result.mipmapMs = MsSince(start);
+    SampleHeap();
+    result.heapPeakMb = heapPeak.inUse / (1024.0 * 1024.0);
+    result.heapSteadyMb = CurrentHeapUsage().inUse / (1024.0 * 1024.0);
+    result.modelSteadyMb = ModelCPUBytes(gltfModel) / (1024.0 * 1024.0);
+    if (!loadTraceDir.empty()) {
+        const std::string name = path.substr(path.find_last_of('/') + 1);
+        const std::string tracePath = loadTraceDir + "/" + name.substr(0, name.find_last_of('.')) + ".load.json";
+        if (!loadProfiler.WriteTrace(tracePath)) std::cerr << "Nie udalo sie zapisac " << tracePath << std::endl;
+    }
+
+    glState.ResetCounters();
+    frameStats.Reset();
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < frames; ++i) {
+        frameStats.BeginFrame();
+        rotY += 0.01f; // Model się obraca jak przy przeciąganiu myszą
+        RenderFrame(kWidth, kHeight);
+        result.visible += frameStats.Current().visible;
+        result.culled += frameStats.Current().culled;
+        double stage = frameStats.StageBegin();
+        eglSwapBuffers(eglDisplay, eglSurface);
+        glFinish();
+        frameStats.StageEnd(kStageSwap, stage);
+        frameStats.EndFrame();
+    }
+    double totalMs = MsSince(start);
+    frameStats.ResolveGpu(); // Po glFinish wyniki ostatnich zapytań są gotowe
+    std::cout << "\n" << path << "\n";
+    frameStats.PrintReport(std::cout);
+    result.frameP95 = frameStats.CpuMs().p95;
+    result.frameP99 = frameStats.CpuMs().p99;
+    result.gpuMs = frameStats.GpuMs().count ? frameStats.GpuMs().p50 : -1;
+    result.triangles = frameStats.Last().triangles;
+    result.visible /= frames;
+    result.culled /= frames;
+    result.frameMs = totalMs / frames;
+    result.fps = 1000.0 * frames / totalMs;
+    result.glIssued = (double)glState.Counters().issued / frames;
+    result.glSkipped = (double)glState.Counters().skipped / frames;
+
+    ReleaseModelGL(myModel);
+    return true;
+}
+
+int main(int argc, char** argv) {
+    std::vector<std::string> args;
+    std::string tracePath;
+    std::string loadTraceDir;
+    for (int i = 1; i < argc; ++i) {
+        if (std::string(argv[i]) == "--trace" && i + 1 < argc) {
+            tracePath = argv[++i]; // Chrome Trace z mierzonych klatek wszystkich plików
+        } else if (std::string(argv[i]) == "--load-trace" && i + 1 < argc) {
+            loadTraceDir = argv[++i]; // Ślad ładowania każdego pliku: katalog/<nazwa>.load.json
+        } else if (std::string(argv[i]) == "--no-batch") {
+            batchStaticMeshes = false; // Porównanie: jeden VBO/EBO i draw call na prymityw
+        } else if (std::string(argv[i]) == "--no-instancing") {
+            instanceRepeatedMeshes = false; // Powtórzone meshe kopiowane do batchy
+        } else if (std::string(argv[i]) == "--quantize") {
+            quantizeVertices = true; // 16-bajtowe wierzchołki + raport błędu dla każdego pliku
+        } else if (std::string(argv[i]) == "--no-direct") {
+            uploadBufferViewsDirectly = false; // Każdy prymityw przepakowany do Vertex
+        } else if (std::string(argv[i]) == "--no-mipmaps") {
+            generateMipmaps = false; // Tekstury tylko z GL_LINEAR (bez łańcucha mipmap)
+        } else if (std::string(argv[i]) == "--no-compressed") {
+            compressTextures = false; // Pomijanie texture_cache - zawsze RGBA8 jak wcześniej
+        } else if (std::string(argv[i]) == "--no-culling") {
+            frustumCulling = false; // Wszystkie meshe rysowane bez testu ostrosłupa
+        } else if (std::string(argv[i]) == "--stages") {
+            frameStats.detailedStages = true; // Uniformy i draw osobno dla każdego mesha
+        } else if (std::string(argv[i]) == "--discard") {
+            discardAfterUpload = true; // Bufory i obrazy gltfModel zwalniane po uploadzie
+        } else {
+            args.push_back(argv[i]);
+        }
+    }
+    int frames = !args.empty() ? std::max(1, std::atoi(args[0].c_str())) : 300;
+
+    std::vector<std::string> files;
+    for (size_t i = 1; i < args.size(); ++i) files.push_back(args[i]);
+    if (files.empty()) {
+        files.push_back("asserts/earth_globe_hologram_2mb_looping_animation.glb");
+        files.push_back("asserts/el.glb");
+    }
+
+    if (!CreateHeadlessContext(kWidth, kHeight)) return 1;
+    if (!InitRenderer(GetGLProcAddress)) return 1;
+
+    if (!tracePath.empty()) frameStats.trace.Start();
+    std::vector<BenchResult> results;
+    for (const auto& file : files) {
+        BenchResult result;
+        if (!BenchFile(file, frames, loadTraceDir, result)) {
+            std::cerr << "Benchmark nie powiodl sie: " << file << std::endl;
+            return 1;
+        }
+        results.push_back(result);
+    }
+    if (!tracePath.empty()) {
+        frameStats.trace.Stop();
+        if (!frameStats.trace.Write(tracePath)) std::cerr << "Nie udalo sie zapisac " << tracePath << std::endl;
+    }
+
+    std::cout << "\n" << kWidth << "x" << kHeight << ", " << frames << " klatek\n";
+    std::cout << std::left << std::setw(58) << "plik" << std::right
+              << std::setw(11) << "parse ms" << std::setw(11) << "decode ms"
+              << std::setw(11) << "upload ms" << std::setw(11) << "frame ms"
+              << std::setw(9) << "p95 ms" << std::setw(9) << "p99 ms" << std::setw(9) << "gpu ms"
+              << std::setw(9) << "fps" << std::setw(10) << "gl/kl"
+              << std::setw(10) << "pomin/kl" << std::setw(7) << "draw" << std::setw(10) << "tri/kl"
+              << std::setw(10) << "widoczne" << std::setw(8) << "odrzuc"
+              << std::setw(10) << "model MB" << std::setw(8) << "po MB"
+              << std::setw(11) << "sterta MB" << std::setw(8) << "po MB"
+              << std::setw(8) << "mip kl" << std::setw(9) << "mip ms" << std::setw(9) << "tex MB" << "\n";
+    for (const auto& r : results) {
+        std::cout << std::left << std::setw(58) << r.file << std::right << std::fixed << std::setprecision(2)
+                  << std::setw(11) << r.parseMs << std::setw(11) << r.decodeMs
+                  << std::setw(11) << r.uploadMs << std::setw(11) << r.frameMs
+                  << std::setw(9) << r.frameP95 << std::setw(9) << r.frameP99 << std::setw(9) << r.gpuMs
+                  << std::setw(9) << std::setprecision(1) << r.fps
+                  << std::setw(10) << r.glIssued << std::setw(10) << r.glSkipped
+                  << std::setw(7) << r.draws << std::setw(10) << r.triangles
+                  << std::setw(10) << r.visible << std::setw(8) << r.culled
+                  << std::setw(10) << r.modelMb << std::setw(8) << r.modelSteadyMb
+                  << std::setw(11) << r.heapPeakMb << std::setw(8) << r.heapSteadyMb
+                  << std::setw(8) << r.mipmapFrames << std::setw(9) << r.mipmapMs << std::setw(9) << r.textureMb << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,142 @@
+// Benchmark grafu sceny z scene_graph.h: przeliczanie tylko poddrzew zmienionych
+// węzłów kontra pełne przejście hierarchii w każdej klatce (dawne UpdateAnimation).
+// Syntetyczna scena: N węzłów w drzewie 4-arnym (rodzic węzła i to (i - 1) / 4),
+// co klatkę k losowych węzłów dostaje nowe TRS. Macierze świata obu metod są porównywane.
+//
+// Budowa (Linux, json.hpp z repozytorium tinygltf):
+//   g++ -O2 -std=c++17 -pthread bench_scene_graph.cpp tiny_gltf.cc -Itinygltf -o bench_scene_graph
+// Użycie:
+//   ./bench_scene_graph [wezly] [klatki]
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include "scene_graph.h"
+#include "tiny_gltf.h"
+
+static double MsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+static uint32_t seed = 12345;
+static float Random() {
+    seed = seed * 1664525u + 1013904223u;
+    return (seed >> 8) / 16777216.0f;
+}
+
+static glm::vec4 RandomRotation() {
+    glm::vec4 q(Random() - 0.5f, Random() - 0.5f, Random() - 0.5f, Random() - 0.5f);
+    return q / std::sqrt(q.x * q.x + q.y * q.y + q.z * q.z + q.w * q.w);
+}
+
+static tinygltf::Model MakeModel(size_t nodes) {
+    tinygltf::Model model;
+    model.nodes.resize(nodes);
+    for (size_t i = 0; i < nodes; ++i) {
+        tinygltf::Node& node = model.nodes[i];
+        node.translation = {Random() - 0.5, Random() - 0.5, Random() - 0.5};
+        const glm::vec4 q = RandomRotation();
+        node.rotation = {q.x, q.y, q.z, q.w};
+        if (i % 7 == 0) node.scale = {0.9 + 0.2 * Random(), 0.9 + 0.2 * Random(), 0.9 + 0.2 * Random()};
+        if (i > 0) model.nodes[(i - 1) / 4].children.push_back((int)i);
+    }
+    model.scenes.resize(1);
+    model.scenes[0].nodes.push_back(0);
+    return model;
+}
+
+// Dawne podejście: wszystkie węzły w kolejności rodzic przed dziećmi, lokalna z TRS i mnożenie glm
+static void UpdateFull(const SceneGraph& graph, std::vector<glm::mat4>& world) {
+    world.resize(graph.Size());
+    for (size_t i = 0; i < graph.Size(); ++i) {
+        const glm::mat4 local = graph.hasMatrix[i] ? graph.local[i]
+                                                   : scene_detail::ComposeTRS(graph.translation[i], graph.rotation[i], graph.scale[i]);
+        world[i] = (graph.parent[i] < 0) ? local : world[graph.parent[i]] * local;
+    }
+}
+
+static float MaxWorldDiff(const SceneGraph& graph, const std::vector<glm::mat4>& world) {
+    float diff = 0.0f;
+    for (size_t i = 0; i < graph.Size(); ++i) {
+        const float* a = glm::value_ptr(graph.world[i]);
+        const float* b = glm::value_ptr(world[i]);
+        for (int c = 0; c < 16; ++c) diff = std::max(diff, std::abs(a[c] - b[c]) / std::max(1.0f, std::abs(b[c])));
+    }
+    return diff;
+}
+
+int main(int argc, char** argv) {
+    const size_t nodes = (argc > 1) ? (size_t)std::max(1, std::atoi(argv[1])) : 100000;
+    const int frames = (argc > 2) ? std::max(1, std::atoi(argv[2])) : 100;
+
+    const tinygltf::Model model = MakeModel(nodes);
+    auto start = std::chrono::steady_clock::now();
+    SceneGraph graph;
+    BuildSceneGraph(model, 0, graph);
+    const double buildMs = MsSince(start);
+    start = std::chrono::steady_clock::now();
+    UpdateSceneGraph(graph);
+    const double firstMs = MsSince(start);
+    std::cout << "\n" << nodes << " wezlow (drzewo 4-arne), " << frames << " klatek; budowa " << std::fixed
+              << std::setprecision(2) << buildMs << " ms, pierwsze przeliczenie " << firstMs << " ms\n";
+    std::cout << std::left << std::setw(10) << "zmienione" << std::right << std::setw(13) << "przeliczone" << std::setw(13)
+              << "brudne [ms]" << std::setw(13) << "skalar [ms]" << std::setw(12) << "pelne [ms]" << std::setw(10)
+              << "x pelne" << std::setw(10) << "ns/wezel" << std::setw(13) << "max roznica" << "\n";
+
+    SceneGraph scalar = graph;
+    std::vector<glm::mat4> full;
+    bool ok = true;
+    for (size_t changed : {(size_t)1, (size_t)10, (size_t)100, (size_t)1000, (size_t)10000, nodes}) {
+        changed = std::min(changed, nodes);
+        double dirtyMs = 0.0, scalarMs = 0.0, fullMs = 0.0;
+        size_t updated = 0;
+        float maxDiff = 0.0f;
+        for (int frame = 0; frame < frames; ++frame) {
+            std::vector<int> edits(changed);
+            std::vector<glm::vec4> rotations(changed);
+            for (size_t e = 0; e < changed; ++e) {
+                edits[e] = (changed == nodes) ? (int)e : (int)(Random() * nodes);
+                rotations[e] = RandomRotation();
+            }
+
+            start = std::chrono::steady_clock::now();
+            for (size_t e = 0; e < changed; ++e) {
+                const int p = graph.position[edits[e]];
+                SetSceneNodeTRS(graph, edits[e], graph.translation[p], rotations[e], graph.scale[p]);
+            }
+            updated += UpdateSceneGraph(graph);
+            dirtyMs += MsSince(start);
+
+            start = std::chrono::steady_clock::now();
+            for (size_t e = 0; e < changed; ++e) {
+                const int p = scalar.position[edits[e]];
+                SetSceneNodeTRS(scalar, edits[e], scalar.translation[p], rotations[e], scalar.scale[p]);
+            }
+            UpdateSceneGraph<false>(scalar);
+            scalarMs += MsSince(start);
+
+            start = std::chrono::steady_clock::now();
+            UpdateFull(graph, full);
+            fullMs += MsSince(start);
+            if (frame == frames - 1) maxDiff = std::max(MaxWorldDiff(graph, full), MaxWorldDiff(scalar, full));
+        }
+        if (maxDiff > 1e-4f) ok = false;
+
+        std::cout << std::left << std::setw(10) << changed << std::right << std::setw(13) << updated / frames << std::fixed
+                  << std::setprecision(3) << std::setw(13) << dirtyMs / frames << std::setw(13) << scalarMs / frames
+                  << std::setw(12) << fullMs / frames << std::setprecision(1) << std::setw(10) << fullMs / dirtyMs
+                  << std::setw(10) << dirtyMs * 1e6 / std::max<double>(1.0, (double)updated) << std::setw(13)
+                  << std::scientific << std::setprecision(1) << maxDiff << "\n";
+        std::cout.unsetf(std::ios_base::floatfield);
+    }
+
+    if (!ok) {
+        std::cerr << "Macierze swiata grafu roznia sie od pelnego przeliczenia!\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,254 @@
+// Benchmark przepustowości wierzchołków: dawny vertex shader (obrót sin/cos
+// i dwie macierze liczone dla każdego wierzchołka) kontra obecny z renderer.h
+// (obrót złożony na CPU w u_mvp / u_normalMatrix). Rysuje N wierzchołków jako
+// trójkąty z glCullFace(GL_FRONT_AND_BACK) - każdy wierzchołek przechodzi przez
+// vertex shader, a rasteryzacja i fragmenty są pomijane.
+//
+// Budowa (Linux):
+//   g++ -O2 -std=c++17 bench_vertex.cpp -lEGL -lGLESv2 -o bench_vertex
+// Użycie:
+//   ./bench_vertex [wierzcholki] [klatki]
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include "headless_egl.h"
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+static const int kSize = 64;
+
+struct Vertex {
+    glm::vec3 position;
+    glm::vec3 normal;
+    glm::vec2 texcoord;
+};
+
+// Shader sprzed przeniesienia obrotu na CPU (z a_instance, jak przy instancingu)
+static const char* kGpuRotationVS = R"(
+    attribute vec3 a_position;
+    attribute vec3 a_normal;
+    attribute vec2 a_texcoord;
+    attribute mat4 a_instance;
+
+    uniform mat4 u_mvp;
+    uniform mat4 u_model;
+    uniform float u_rotX;
+    uniform float u_rotY;
+
+    varying vec3 v_normal;
+    varying vec2 v_texcoord;
+
+    void main() {
+        float cx = cos(u_rotX), sx = sin(u_rotX);
+        float cy = cos(u_rotY), sy = sin(u_rotY);
+        mat4 Rx = mat4(
+            1.0, 0.0, 0.0, 0.0,
+            0.0, cx,  -sx, 0.0,
+            0.0, sx,  cx,  0.0,
+            0.0, 0.0, 0.0, 1.0
+        );
+        mat4 Ry = mat4(
+            cy, 0.0, sy, 0.0,
+            0.0, 1.0, 0.0, 0.0,
+            -sy, 0.0, cy, 0.0,
+            0.0, 0.0, 0.0, 1.0
+        );
+
+        mat4 rotatedModel = Ry * Rx * u_model * a_instance;
+
+        gl_Position = u_mvp * rotatedModel * vec4(a_position, 1.0);
+        v_normal = mat3(rotatedModel) * a_normal;
+        v_texcoord = a_texcoord;
+    }
+)";
+
+// Shader z renderer.h (obrót w u_mvp)
+static const char* kCpuRotationVS = R"(
+    attribute vec3 a_position;
+    attribute vec3 a_normal;
+    attribute vec2 a_texcoord;
+    attribute mat4 a_instance;
+
+    uniform mat4 u_mvp;
+    uniform mat3 u_normalMatrix;
+
+    varying vec3 v_normal;
+    varying vec2 v_texcoord;
+
+    void main() {
+        gl_Position = u_mvp * a_instance * vec4(a_position, 1.0);
+        v_normal = u_normalMatrix * mat3(a_instance) * a_normal;
+        v_texcoord = a_texcoord;
+    }
+)";
+
+static const char* kFragmentSrc = R"(
+    precision mediump float;
+
+    varying vec3 v_normal;
+    varying vec2 v_texcoord;
+
+    void main() {
+        vec3 lightDir = normalize(vec3(0.5, 1.0, 0.3));
+        float light = max(dot(normalize(v_normal), lightDir), 0.0);
+        gl_FragColor = vec4(vec3(v_texcoord, 1.0) * light, 1.0);
+    }
+)";
+
+static GLuint CompileShader(GLenum type, const char* source) {
+    GLuint shader = glCreateShader(type);
+    glShaderSource(shader, 1, &source, nullptr);
+    glCompileShader(shader);
+
+    GLint compiled;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &compiled);
+    if (!compiled) {
+        char log[512];
+        glGetShaderInfoLog(shader, 512, nullptr, log);
+        std::cerr << "Shader compile error: " << log << std::endl;
+        glDeleteShader(shader);
+        return 0;
+    }
+    return shader;
+}
+
+static GLuint CreateProgram(const char* vertexSrc) {
+    GLuint vs = CompileShader(GL_VERTEX_SHADER, vertexSrc);
+    GLuint fs = CompileShader(GL_FRAGMENT_SHADER, kFragmentSrc);
+    if (vs == 0 || fs == 0) return 0;
+
+    GLuint program = glCreateProgram();
+    glAttachShader(program, vs);
+    glAttachShader(program, fs);
+    glLinkProgram(program);
+    glDeleteShader(vs);
+    glDeleteShader(fs);
+
+    GLint linked;
+    glGetProgramiv(program, GL_LINK_STATUS, &linked);
+    if (!linked) {
+        char log[512];
+        glGetProgramInfoLog(program, 512, nullptr, log);
+        std::cerr << "Program link error: " << log << std::endl;
+        glDeleteProgram(program);
+        return 0;
+    }
+    return program;
+}
+
+// --- Punkty na kuli (pozycja = normalna); kolejne trójki tworzą trójkąty ---
+static std::vector<Vertex> MakeSphere(int vertexCount) {
+    std::vector<Vertex> vertices(vertexCount);
+    const float golden = 2.39996323f;
+    for (int i = 0; i < vertexCount; ++i) {
+        float y = 1.0f - 2.0f * (i + 0.5f) / vertexCount;
+        float r = std::sqrt(1.0f - y * y);
+        glm::vec3 p(r * std::cos(golden * i), y, r * std::sin(golden * i));
+        vertices[i] = {p, p, glm::vec2(0.5f + 0.5f * p.x, 0.5f + 0.5f * p.y)};
+    }
+    return vertices;
+}
+
+// --- Średni czas klatki (ms) dla programu; setUniforms wywoływane raz na klatkę ---
+template <typename SetUniforms>
+static double TimeProgram(GLuint program, GLsizei vertexCount, int frames, SetUniforms setUniforms) {
+    glUseProgram(program);
+
+    GLint pos = glGetAttribLocation(program, "a_position");
+    GLint norm = glGetAttribLocation(program, "a_normal");
+    GLint tex = glGetAttribLocation(program, "a_texcoord");
+    GLint inst = glGetAttribLocation(program, "a_instance");
+    glEnableVertexAttribArray(pos);
+    glVertexAttribPointer(pos, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, position));
+    glEnableVertexAttribArray(norm);
+    glVertexAttribPointer(norm, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, normal));
+    glEnableVertexAttribArray(tex);
+    glVertexAttribPointer(tex, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, texcoord));
+    const glm::mat4 identity(1.0f);
+    for (int column = 0; column < 4; ++column) glVertexAttrib4fv(inst + column, glm::value_ptr(identity[column]));
+
+    // Rozgrzewka
+    setUniforms(program, 0.0f);
+    glDrawArrays(GL_TRIANGLES, 0, vertexCount);
+    glFinish();
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < frames; ++i) {
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        setUniforms(program, 0.01f * i);
+        glDrawArrays(GL_TRIANGLES, 0, vertexCount);
+        glFinish();
+    }
+    double totalMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    glDisableVertexAttribArray(pos);
+    glDisableVertexAttribArray(norm);
+    glDisableVertexAttribArray(tex);
+    return totalMs / frames;
+}
+
+int main(int argc, char** argv) {
+    int vertexCount = (argc > 1) ? std::max(3, std::atoi(argv[1])) : 500001;
+    vertexCount -= vertexCount % 3;
+    int frames = (argc > 2) ? std::max(1, std::atoi(argv[2])) : 100;
+
+    if (!CreateHeadlessContext(kSize, kSize)) return 1;
+    glViewport(0, 0, kSize, kSize);
+    glEnable(GL_DEPTH_TEST);
+    glEnable(GL_CULL_FACE);
+    glCullFace(GL_FRONT_AND_BACK); // Mierzymy tylko etap wierzchołków
+
+    GLuint gpuProgram = CreateProgram(kGpuRotationVS);
+    GLuint cpuProgram = CreateProgram(kCpuRotationVS);
+    if (!gpuProgram || !cpuProgram) return 1;
+
+    std::vector<Vertex> vertices = MakeSphere(vertexCount);
+    GLuint vbo;
+    glGenBuffers(1, &vbo);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(Vertex) * vertices.size(), vertices.data(), GL_STATIC_DRAW);
+
+    const glm::mat4 projection = glm::perspective(glm::radians(45.0f), 1.0f, 0.1f, 100.0f);
+    const glm::mat4 view = glm::lookAt(glm::vec3(0, 0, 5), glm::vec3(0), glm::vec3(0, 1, 0));
+    const glm::mat4 model(1.0f);
+
+    double gpuMs = TimeProgram(gpuProgram, vertexCount, frames, [&](GLuint program, float angle) {
+        glm::mat4 mvp = projection * view * model;
+        glUniformMatrix4fv(glGetUniformLocation(program, "u_mvp"), 1, GL_FALSE, glm::value_ptr(mvp));
+        glUniformMatrix4fv(glGetUniformLocation(program, "u_model"), 1, GL_FALSE, glm::value_ptr(model));
+        glUniform1f(glGetUniformLocation(program, "u_rotX"), angle * 0.5f);
+        glUniform1f(glGetUniformLocation(program, "u_rotY"), angle);
+    });
+
+    double cpuMs = TimeProgram(cpuProgram, vertexCount, frames, [&](GLuint program, float angle) {
+        glm::mat4 rotation = glm::rotate(glm::mat4(1.0f), -angle, glm::vec3(0, 1, 0)) *
+                             glm::rotate(glm::mat4(1.0f), -angle * 0.5f, glm::vec3(1, 0, 0));
+        glm::mat4 world = rotation * model;
+        glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3(world)));
+        glm::mat4 mvp = projection * view * world;
+        glUniformMatrix4fv(glGetUniformLocation(program, "u_mvp"), 1, GL_FALSE, glm::value_ptr(mvp));
+        glUniformMatrix3fv(glGetUniformLocation(program, "u_normalMatrix"), 1, GL_FALSE, glm::value_ptr(normalMatrix));
+    });
+
+    std::cout << "\n" << vertexCount << " wierzcholkow, " << frames << " klatek\n";
+    std::cout << std::left << std::setw(22) << "shader" << std::right
+              << std::setw(12) << "ms/klatke" << std::setw(14) << "Mwierzch/s" << "\n";
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << std::left << std::setw(22) << "obrot w shaderze" << std::right
+              << std::setw(12) << gpuMs << std::setw(14) << vertexCount / gpuMs / 1000.0 << "\n";
+    std::cout << std::left << std::setw(22) << "obrot na CPU" << std::right
+              << std::setw(12) << cpuMs << std::setw(14) << vertexCount / cpuMs / 1000.0 << "\n";
+    std::cout << "przyspieszenie: x" << gpuMs / cpuMs << "\n";
+
+    glDeleteBuffers(1, &vbo);
+    glDeleteProgram(gpuProgram);
+    glDeleteProgram(cpuProgram);
+    return 0;
+}
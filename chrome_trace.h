@@ -0,0 +1,132 @@
+// Zapis zdarzeń w formacie Chrome Trace (JSON "traceEvents"), do otwarcia w
+// chrome://tracing albo ui.perfetto.dev. Używany przez statystyki klatek (frame_stats.h).
+// Zdarzenia są trzymane w pamięci do Write; powyżej maxEvents nowe są pomijane,
+// żeby długie nagranie nie rosło bez końca.
+//
+// W przeglądarce plik trafia do MEMFS, więc Write dodatkowo pobiera go jako plik
+// (Blob + link), a natywnie zostaje na dysku.
+#ifndef CHROME_TRACE_H_
+#define CHROME_TRACE_H_
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#ifdef __EMSCRIPTEN__
+#include <emscripten.h>
+#endif
+
+// Mikrosekundy od pierwszego wywołania - wspólna oś czasu wszystkich zdarzeń
+inline double TraceNowUs() {
+    static const auto start = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+}
+
+struct TraceEvent {
+    std::string name;
+    const char* category = "";
+    char phase = 'X';   // 'X' - odcinek (ts + dur), 'C' - licznik (value), 'M' - nazwa wątku
+    double ts = 0;      // us
+    double dur = 0;     // us
+    int tid = 0;        // Ścieżka w widoku (np. CPU / GPU)
+    double value = 0;
+};
+
+class ChromeTrace {
+public:
+    size_t maxEvents = 1000000;
+
+    bool Recording() const { return recording_; }
+
+    void Start() {
+        events_.clear();
+        recording_ = true;
+    }
+    void Stop() { recording_ = false; }
+    size_t EventCount() const { return events_.size(); }
+
+    void ThreadName(int tid, const char* name) {
+        TraceEvent event;
+        event.name = name;
+        event.phase = 'M';
+        event.tid = tid;
+        threadNames_.push_back(event);
+    }
+
+    void Complete(const std::string& name, const char* category, double startUs, double durationUs, int tid) {
+        if (!recording_ || events_.size() >= maxEvents) return;
+        TraceEvent event;
+        event.name = name;
+        event.category = category;
+        event.ts = startUs;
+        event.dur = durationUs;
+        event.tid = tid;
+        events_.push_back(std::move(event));
+    }
+
+    void Counter(const std::string& name, const char* category, double tsUs, double value) {
+        if (!recording_ || events_.size() >= maxEvents) return;
+        TraceEvent event;
+        event.name = name;
+        event.category = category;
+        event.phase = 'C';
+        event.ts = tsUs;
+        event.value = value;
+        events_.push_back(std::move(event));
+    }
+
+    // --- Zapis JSON; w przeglądarce także pobranie pliku ---
+    bool Write(const std::string& path) const {
+        FILE* file = std::fopen(path.c_str(), "w");
+        if (!file) return false;
+        std::fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+        bool first = true;
+        auto writeEvent = [&](const TraceEvent& e) {
+            std::fprintf(file, "%s", first ? "" : ",\n");
+            first = false;
+            if (e.phase == 'M') {
+                std::fprintf(file, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s\"}}",
+                             e.tid, Escape(e.name).c_str());
+                return;
+            }
+            std::fprintf(file, "{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"%c\",\"pid\":1,\"tid\":%d,\"ts\":%.3f",
+                         Escape(e.name).c_str(), e.category, e.phase, e.tid, e.ts);
+            if (e.phase == 'X') std::fprintf(file, ",\"dur\":%.3f}", e.dur);
+            if (e.phase == 'C') std::fprintf(file, ",\"args\":{\"value\":%.3f}}", e.value);
+        };
+        for (const TraceEvent& e : threadNames_) writeEvent(e);
+        for (const TraceEvent& e : events_) writeEvent(e);
+        std::fprintf(file, "\n]}\n");
+        const bool ok = std::fclose(file) == 0;
+#ifdef __EMSCRIPTEN__
+        if (ok) {
+            EM_ASM({
+                var path = UTF8ToString($0);
+                var blob = new Blob([FS.readFile(path)], {type: 'application/json'});
+                var link = document.createElement('a');
+                link.href = URL.createObjectURL(blob);
+                link.download = path.split('/').pop();
+                link.click();
+            }, path.c_str());
+        }
+#endif
+        return ok;
+    }
+
+private:
+    static std::string Escape(const std::string& s) {
+        std::string out;
+        for (char c : s) {
+            if (c == '"' || c == '\\') out += '\\';
+            if ((unsigned char)c >= 0x20) out += c;
+        }
+        return out;
+    }
+
+    bool recording_ = false;
+    std::vector<TraceEvent> events_;
+    std::vector<TraceEvent> threadNames_;
+};
+
+#endif  // CHROME_TRACE_H_
@@ -0,0 +1,170 @@
+// Koder tekstur do pamięci podręcznej texture_compression.h: dla każdego obrazu koloru
+// bazowego z plików GLB (tylko te renderer wczytuje) zapisuje łańcuch mipmap w S3TC (DXT1 / DXT5) i ETC1 (tylko obrazy bez alfy) jako
+// "<hash>.<rodzina>.ctex". Obrazy już obecne w katalogu są pomijane, więc narzędzie można
+// uruchamiać przy każdym buildzie (np. przed em++, żeby --preload-file asserts zabrał pliki).
+//
+// Budowa (Linux, json.hpp / stb_image_write.h z repozytorium tinygltf):
+//   g++ -O2 -std=c++17 -pthread encode_textures.cpp tiny_gltf.cc -Itinygltf -o encode_textures
+// Użycie:
+//   ./encode_textures [--out katalog] [plik.glb ...]
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "texture_compression.h"
+#include "tiny_gltf.h"
+
+static double MsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+struct EncodeTask {
+    std::string file;
+    const tinygltf::Image* image = nullptr;
+    int imageIndex = 0;
+    std::string log; // Wątki nie piszą na cout równocześnie - raport wypisujemy po join
+    bool ok = true;
+};
+
+// Format GL z nagłówka pliku .ctex (0 = brak pliku)
+static uint32_t CachedFormat(const std::string& path) {
+    FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) return 0;
+    char magic[8];
+    uint32_t format = 0;
+    if (std::fread(magic, 1, 8, file) != 8 || std::memcmp(magic, kCompressedMagic, 8) != 0 ||
+        std::fread(&format, sizeof(format), 1, file) != 1) {
+        format = 0;
+    }
+    std::fclose(file);
+    return format;
+}
+
+static void EncodeImage(EncodeTask& task) {
+    const tinygltf::Image& image = *task.image;
+    const uint64_t hash = HashImageBytes(image.image.data(), image.image.size());
+
+    // DXT5 w pamięci podręcznej = obraz z alfą, dla którego ETC1 i tak nie powstanie
+    const uint32_t s3tcFormat = CachedFormat(CompressedCachePath(hash, CompressedFamily::S3TC));
+    std::vector<CompressedFamily> missing;
+    if (s3tcFormat == 0) missing.push_back(CompressedFamily::S3TC);
+    if (s3tcFormat != GL_COMPRESSED_RGBA_S3TC_DXT5_EXT && CachedFormat(CompressedCachePath(hash, CompressedFamily::ETC1)) == 0) {
+        missing.push_back(CompressedFamily::ETC1);
+    }
+    std::ostringstream log;
+    log << task.file << " obraz " << task.imageIndex << " (" << image.name << "): ";
+    if (missing.empty()) {
+        task.log = log.str() + "w pamieci podrecznej\n";
+        return;
+    }
+
+    tinygltf::Image decoded;
+    std::string err, warn;
+    if (!tinygltf::DecodeImageAsIs(image, &decoded, task.imageIndex, &err, &warn) || decoded.bits != 8) {
+        task.log = log.str() + "nie udalo sie zdekodowac " + err + "\n";
+        task.ok = false;
+        return;
+    }
+    MipLevel base;
+    base.width = decoded.width;
+    base.height = decoded.height;
+    base.pixels = std::move(decoded.image);
+
+    const double rawMb = base.pixels.size() * (IsPowerOfTwo(base.width) && IsPowerOfTwo(base.height) ? 4.0 / 3.0 : 1.0) /
+                         (1024.0 * 1024.0);
+    log << base.width << "x" << base.height << ", RGBA8 " << std::fixed << std::setprecision(1) << rawMb << " MB";
+    for (CompressedFamily family : missing) {
+        auto start = std::chrono::steady_clock::now();
+        CompressedTexture compressed;
+        if (!EncodeCompressedTexture(base, decoded.component, family, compressed)) {
+            log << ", " << CompressedFamilyName(family) << " nie pasuje";
+            continue;
+        }
+        if (!WriteCompressedTexture(CompressedCachePath(hash, family), compressed)) {
+            log << ", " << CompressedFamilyName(family) << " blad zapisu";
+            task.ok = false;
+            continue;
+        }
+        log << ", " << CompressedFamilyName(family) << " " << CompressedTextureBytes(compressed) / (1024.0 * 1024.0)
+            << " MB (" << compressed.levels.size() << " poziomow, " << std::setprecision(0) << MsSince(start) << " ms)"
+            << std::setprecision(1);
+    }
+    task.log = log.str() + "\n";
+}
+
+int main(int argc, char** argv) {
+    std::vector<std::string> files;
+    for (int i = 1; i < argc; ++i) {
+        if (std::string(argv[i]) == "--out" && i + 1 < argc) {
+            textureCacheDir = argv[++i];
+        } else {
+            files.push_back(argv[i]);
+        }
+    }
+    if (files.empty()) {
+        files.push_back("asserts/earth_globe_hologram_2mb_looping_animation.glb");
+        files.push_back("asserts/el.glb");
+    }
+
+    std::error_code ec;
+    std::filesystem::create_directories(textureCacheDir, ec);
+    if (ec) {
+        std::cerr << "Nie mozna utworzyc katalogu " << textureCacheDir << ": " << ec.message() << std::endl;
+        return 1;
+    }
+
+    // Modele żyją do końca - zadania trzymają wskaźniki do ich obrazów
+    std::vector<tinygltf::Model> models(files.size());
+    std::vector<EncodeTask> tasks;
+    for (size_t f = 0; f < files.size(); ++f) {
+        tinygltf::TinyGLTF loader;
+        loader.SetImagesAsIs(true); // Hash liczymy z bajtów PNG/JPEG, tak jak renderer
+        std::string err, warn;
+        if (!loader.LoadBinaryFromFile(&models[f], &err, &warn, files[f])) {
+            std::cerr << "Nie udalo sie wczytac " << files[f] << ": " << err << std::endl;
+            return 1;
+        }
+        std::set<int> sources;
+        for (const auto& material : models[f].materials) {
+            const int texture = material.pbrMetallicRoughness.baseColorTexture.index;
+            if (texture >= 0 && texture < (int)models[f].textures.size()) sources.insert(models[f].textures[texture].source);
+        }
+        for (int i : sources) {
+            if (i < 0 || i >= (int)models[f].images.size() || !models[f].images[i].as_is) continue;
+            EncodeTask task;
+            task.file = files[f];
+            task.image = &models[f].images[i];
+            task.imageIndex = i;
+            tasks.push_back(task);
+        }
+    }
+
+    // Obrazy są niezależne - po jednym wątku na obraz, w paczkach po liczbie rdzeni
+    auto start = std::chrono::steady_clock::now();
+    const size_t threads = std::max(1u, std::thread::hardware_concurrency());
+    for (size_t first = 0; first < tasks.size(); first += threads) {
+        std::vector<std::thread> workers;
+        for (size_t i = first; i < std::min(tasks.size(), first + threads); ++i) {
+            workers.emplace_back(EncodeImage, std::ref(tasks[i]));
+        }
+        for (auto& worker : workers) worker.join();
+    }
+
+    bool ok = true;
+    for (const auto& task : tasks) {
+        std::cout << task.log;
+        ok = ok && task.ok;
+    }
+    std::cout << "Obrazy: " << tasks.size() << ", katalog: " << textureCacheDir << ", " << std::fixed
+              << std::setprecision(0) << MsSince(start) << " ms" << std::endl;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,253 @@
+// Pomiar klatek: czas CPU z podziałem na etapy (zdarzenia, animacja, odrzucanie, tekstury,
+// uniformy, wysyłanie draw calli, swap), czas GPU z EXT_disjoint_timer_query, liczniki
+// draw calli, trójkątów i obiektów widocznych / odrzuconych przez frustum culling
+// oraz percentyle z ostatnich kWindow klatek.
+// Uniformy i draw calle są domyślnie mierzone jednym pomiarem na całą pętlę meshy
+// (etap "draw", uniformy wliczone). Podział per mesh - 4 odczyty zegara na draw call -
+// tylko w czasie nagrania Chrome Trace (chrome_trace.h) albo z detailedStages.
+//
+// Wyniki zapytań GPU przychodzą z opóźnieniem kilku klatek (pierścień kQueries
+// zapytań, bez czekania na GPU). W przeglądarce SDL_GL_SwapWindow nic nie robi -
+// kompozycja następuje po powrocie z main_loop, więc "swap" jest tam bliski zera,
+// a czas oczekiwania na vsync widać dopiero w odstępie między klatkami.
+#ifndef FRAME_STATS_H_
+#define FRAME_STATS_H_
+
+#include <GLES2/gl2.h>
+#include <GLES2/gl2ext.h>
+#include <algorithm>
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "chrome_trace.h"
+#include "gl_ext.h"
+
+enum FrameStage {
+    kStageEvents, kStageAnimation, kStageCulling, kStageTextures, kStageUniforms, kStageDraw, kStageSwap, kFrameStageCount
+};
+
+inline const char* FrameStageName(int stage) {
+    static const char* const kNames[kFrameStageCount] = {"zdarzenia", "animacja", "odrzucanie", "tekstury", "uniformy", "draw", "swap"};
+    return kNames[stage];
+}
+
+struct FrameSample {
+    double intervalMs = 0; // Od początku poprzedniej klatki (z vsync)
+    double cpuMs = 0;      // BeginFrame -> EndFrame
+    double stageMs[kFrameStageCount] = {};
+    unsigned draws = 0;
+    unsigned long long triangles = 0;
+    unsigned visible = 0, culled = 0; // Meshe / instancje po frustum cullingu
+    bool detailedStages = false;      // Uniformy mierzone osobno (inaczej wliczone w "draw")
+};
+
+struct Percentiles {
+    double p50 = 0, p95 = 0, p99 = 0, max = 0;
+    size_t count = 0;
+};
+
+class FrameStats {
+public:
+    static const int kWindow = 240;
+    static const int kQueries = 4;
+    static const int kCpuTid = 1;
+    static const int kGpuTid = 2;
+
+    // Wyłączone = tylko liczniki draw/trójkątów, bez odczytów zegara i zapytań GPU
+    bool enabled = true;
+    // Podział uniformy / draw per mesh także bez nagrywania (np. bench_render --stages)
+    bool detailedStages = false;
+    ChromeTrace trace;
+
+    FrameStats() : samples_(kWindow), gpuMs_(kWindow) {
+        trace.ThreadName(kCpuTid, "CPU");
+        trace.ThreadName(kGpuTid, "GPU");
+    }
+
+    void BeginFrame() {
+        const double now = enabled ? TraceNowUs() : 0;
+        current_ = FrameSample();
+        current_.detailedStages = DetailedStages();
+        current_.intervalMs = (frameStartUs_ > 0) ? (now - frameStartUs_) / 1000.0 : 0;
+        frameStartUs_ = now;
+    }
+
+    void EndFrame() {
+        if (enabled) {
+            const double now = TraceNowUs();
+            current_.cpuMs = (now - frameStartUs_) / 1000.0;
+            trace.Complete("klatka", "frame", frameStartUs_, now - frameStartUs_, kCpuTid);
+            trace.Counter("draw calle", "frame", frameStartUs_, current_.draws);
+            trace.Counter("trojkaty", "frame", frameStartUs_, (double)current_.triangles);
+            trace.Counter("widoczne", "frame", frameStartUs_, current_.visible);
+            trace.Counter("odrzucone", "frame", frameStartUs_, current_.culled);
+        }
+        samples_[frameCount_ % kWindow] = current_;
+        ++frameCount_;
+    }
+
+    // --- Etapy CPU: begin = StageBegin(), potem StageEnd(etap, begin); etap może wystąpić wiele razy ---
+    double StageBegin() const { return enabled ? TraceNowUs() : 0; }
+    void StageEnd(FrameStage stage, double beginUs) {
+        if (!enabled) return;
+        const double end = TraceNowUs();
+        current_.stageMs[stage] += (end - beginUs) / 1000.0;
+        trace.Complete(FrameStageName(stage), "cpu", beginUs, end - beginUs, kCpuTid);
+    }
+
+    bool DetailedStages() const { return enabled && (detailedStages || trace.Recording()); }
+
+    void CountCulling(unsigned visible, unsigned culled) {
+        current_.visible += visible;
+        current_.culled += culled;
+    }
+
+    void CountDraw(GLsizei indexCount, GLsizei instances = 1) {
+        ++current_.draws;
+        current_.triangles += (unsigned long long)(indexCount / 3) * instances;
+    }
+
+    // --- Czas GPU pracy między BeginGpu i EndGpu (RenderFrame) ---
+    void BeginGpu() {
+        if (!enabled || !glExt.timerQuery) return;
+        if (queries_[0] == 0) glExt.genQueries(kQueries, queries_);
+        ResolveGpu();
+        if (issued_ - resolved_ >= (unsigned)kQueries) return; // Wszystkie zapytania w drodze - ta klatka bez pomiaru
+        const int slot = issued_ % kQueries;
+        glExt.beginQuery(GL_TIME_ELAPSED_EXT, queries_[slot]);
+        queryStartUs_[slot] = TraceNowUs();
+        gpuActive_ = true;
+    }
+
+    void EndGpu() {
+        if (!gpuActive_) return;
+        glExt.endQuery(GL_TIME_ELAPSED_EXT);
+        ++issued_;
+        gpuActive_ = false;
+    }
+
+    // Odczyt gotowych wyników, od najstarszego; bez blokowania
+    void ResolveGpu() {
+        if (issued_ == resolved_) return;
+        GLint disjoint = 0;
+        glGetIntegerv(GL_GPU_DISJOINT_EXT, &disjoint); // Np. zmiana taktowania GPU - wyniki niewiarygodne
+        while (resolved_ < issued_) {
+            const int slot = resolved_ % kQueries;
+            GLuint available = 0;
+            glExt.getQueryObjectuiv(queries_[slot], GL_QUERY_RESULT_AVAILABLE_EXT, &available);
+            if (!available) break;
+            GLuint64 ns = 0;
+            glExt.getQueryObjectui64v(queries_[slot], GL_QUERY_RESULT_EXT, &ns);
+            ++resolved_;
+            if (disjoint) continue;
+            gpuMs_[gpuCount_ % kWindow] = ns / 1e6;
+            ++gpuCount_;
+            trace.Complete("GPU", "gpu", queryStartUs_[slot], ns / 1000.0, kGpuTid);
+        }
+    }
+
+    // Nowy kontekst GL (InitRenderer) - stare zapytania nie istnieją
+    void ResetGpu() {
+        std::fill(queries_, queries_ + kQueries, 0u);
+        issued_ = resolved_ = 0;
+        gpuActive_ = false;
+    }
+
+    void Reset() {
+        frameCount_ = gpuCount_ = 0;
+        frameStartUs_ = 0;
+    }
+
+    size_t FrameCount() const { return std::min<size_t>(frameCount_, kWindow); }
+    const FrameSample& Current() const { return current_; } // Klatka w toku (przed EndFrame)
+    const FrameSample& Last() const { return samples_[(frameCount_ + kWindow - 1) % kWindow]; }
+
+    template <typename Metric>
+    Percentiles FramePercentiles(Metric metric) const {
+        std::vector<double> values;
+        for (size_t i = 0; i < FrameCount(); ++i) values.push_back(metric(samples_[i]));
+        return Compute(values);
+    }
+    Percentiles CpuMs() const { return FramePercentiles([](const FrameSample& s) { return s.cpuMs; }); }
+    Percentiles IntervalMs() const { return FramePercentiles([](const FrameSample& s) { return s.intervalMs; }); }
+    Percentiles StageMs(int stage) const { return FramePercentiles([stage](const FrameSample& s) { return s.stageMs[stage]; }); }
+    Percentiles GpuMs() const {
+        return Compute(std::vector<double>(gpuMs_.begin(), gpuMs_.begin() + std::min<size_t>(gpuCount_, kWindow)));
+    }
+
+    // --- Jedna linia do tytułu okna (nakładka) ---
+    std::string Summary() const {
+        const Percentiles interval = IntervalMs(), cpu = CpuMs(), gpu = GpuMs();
+        char text[256];
+        int n = std::snprintf(text, sizeof(text), "%.0f fps | CPU %.2f ms (p95 %.2f, p99 %.2f)",
+                              interval.p50 > 0 ? 1000.0 / interval.p50 : 0.0, cpu.p50, cpu.p95, cpu.p99);
+        if (gpu.count > 0) {
+            n += std::snprintf(text + n, sizeof(text) - n, " | GPU %.2f ms (p95 %.2f)", gpu.p50, gpu.p95);
+        }
+        std::snprintf(text + n, sizeof(text) - n, " | %u draw, %llu tri | %u/%u widoczne", Last().draws, Last().triangles,
+                      Last().visible, Last().visible + Last().culled);
+        return text;
+    }
+
+    // --- Tabela percentyli (konsola, benchmark) ---
+    void PrintReport(std::ostream& out) const {
+        auto row = [&](const std::string& name, const Percentiles& p) {
+            out << std::left << std::setw(12) << name << std::right << std::fixed << std::setprecision(3)
+                << std::setw(9) << p.p50 << std::setw(9) << p.p95 << std::setw(9) << p.p99 << std::setw(9) << p.max << "\n";
+        };
+        out << "Klatki: " << FrameCount() << " (ostatnie), " << Last().draws << " draw, " << Last().triangles << " trojkatow, "
+            << Last().visible << " widocznych / " << Last().culled << " odrzuconych obiektow\n";
+        out << std::left << std::setw(12) << "ms" << std::right << std::setw(9) << "p50" << std::setw(9) << "p95"
+            << std::setw(9) << "p99" << std::setw(9) << "max" << "\n";
+        row("odstep", IntervalMs());
+        row("CPU", CpuMs());
+        // Bez podziału etapów w każdej klatce okna uniformy nie są mierzone - zero byłoby mylące
+        bool uniformsMeasured = true;
+        for (size_t i = 0; i < FrameCount(); ++i) uniformsMeasured = uniformsMeasured && samples_[i].detailedStages;
+        for (int stage = 0; stage < kFrameStageCount; ++stage) {
+            const std::string name = std::string("  ") + FrameStageName(stage);
+            if (stage == kStageUniforms && !uniformsMeasured) {
+                out << std::left << std::setw(12) << name << std::right << std::setw(9) << "n/a" << "  (draw zawiera uniformy)\n";
+                continue;
+            }
+            row(name, StageMs(stage));
+        }
+        if (GpuMs().count > 0) row("GPU", GpuMs());
+        else out << "GPU: brak EXT_disjoint_timer_query\n";
+        out.unsetf(std::ios_base::floatfield);
+    }
+
+private:
+    // Percentyl metodą najbliższej rangi
+    static Percentiles Compute(std::vector<double> values) {
+        Percentiles p;
+        p.count = values.size();
+        if (values.empty()) return p;
+        std::sort(values.begin(), values.end());
+        auto rank = [&](double q) { return values[std::min(values.size() - 1, (size_t)(q * values.size()))]; };
+        p.p50 = rank(0.50);
+        p.p95 = rank(0.95);
+        p.p99 = rank(0.99);
+        p.max = values.back();
+        return p;
+    }
+
+    std::vector<FrameSample> samples_;
+    std::vector<double> gpuMs_;
+    size_t frameCount_ = 0;
+    size_t gpuCount_ = 0;
+    FrameSample current_;
+    double frameStartUs_ = 0;
+
+    GLuint queries_[kQueries] = {};
+    double queryStartUs_[kQueries] = {};
+    unsigned issued_ = 0, resolved_ = 0;
+    bool gpuActive_ = false;
+};
+
+inline FrameStats frameStats;
+
+#endif  // FRAME_STATS_H_
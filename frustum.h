@@ -0,0 +1,192 @@
+// Odrzucanie meshy poza ostrosłupem widzenia. Każdy MeshGL ma AABB w swoim układzie
+// (min/max akcesora POSITION albo wierzchołków przy uploadzie); co klatkę AABB jest
+// przenoszone macierzą świata, a z wyniku powstaje sfera (środek + długość półprzekątnej).
+// Sfery leżą w tablicach SoA i są testowane po 4 naraz z 6 płaszczyznami wyciągniętymi
+// z macierzy clip (SSE2 / WASM SIMD128, wersja skalarna jako referencja).
+#ifndef FRUSTUM_H_
+#define FRUSTUM_H_
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "tiny_gltf.h"
+#include <glm/glm.hpp>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define FRUSTUM_SSE2 1
+#elif defined(__wasm_simd128__)
+#include <wasm_simd128.h>
+#define FRUSTUM_WASM_SIMD 1
+#endif
+
+// Płaszczyzny lewa, prawa, dolna, górna, bliska, daleka: a*x + b*y + c*z + d >= 0 wewnątrz
+struct FrustumPlanes {
+    float a[6], b[6], c[6], d[6];
+};
+
+// Sfery do testu (SoA); reszta z dzielenia przez 4 testowana skalarnie
+struct BoundingSpheres {
+    std::vector<float> x, y, z, radius;
+    size_t count = 0;
+
+    void Clear() {
+        x.clear();
+        y.clear();
+        z.clear();
+        radius.clear();
+        count = 0;
+    }
+
+    void Push(const glm::vec3& center, float r) {
+        x.push_back(center.x);
+        y.push_back(center.y);
+        z.push_back(center.z);
+        radius.push_back(r);
+        ++count;
+    }
+
+    // Sfera nieodrzucalna (mesh bez AABB: skinning, morph targety)
+    void PushAlwaysVisible() { Push(glm::vec3(0.0f), INFINITY); }
+};
+
+// --- AABB akcesora POSITION z min/max (wymagane przez glTF); false bez nich ---
+// Dla znormalizowanych typów całkowitych (KHR_mesh_quantization) min/max są w jednostkach typu.
+inline bool AccessorBounds(const tinygltf::Accessor& accessor, glm::vec3& min, glm::vec3& max) {
+    if (accessor.minValues.size() != 3 || accessor.maxValues.size() != 3) return false;
+    float scale = 1.0f, lowest = -INFINITY;
+    if (accessor.normalized) {
+        switch (accessor.componentType) {
+        case TINYGLTF_COMPONENT_TYPE_BYTE: scale = 1.0f / 127.0f; lowest = -1.0f; break;
+        case TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE: scale = 1.0f / 255.0f; break;
+        case TINYGLTF_COMPONENT_TYPE_SHORT: scale = 1.0f / 32767.0f; lowest = -1.0f; break;
+        case TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT: scale = 1.0f / 65535.0f; break;
+        default: break;
+        }
+    }
+    for (int c = 0; c < 3; ++c) {
+        min[c] = std::max((float)accessor.minValues[c] * scale, lowest);
+        max[c] = std::max((float)accessor.maxValues[c] * scale, lowest);
+    }
+    return true;
+}
+
+// --- AABB wierzchołków (pozycja to pierwsze 3 floaty z `stride`) ---
+inline void VertexBounds(const float* vertices, size_t count, size_t stride, glm::vec3& min, glm::vec3& max) {
+    min = glm::vec3(INFINITY);
+    max = glm::vec3(-INFINITY);
+    for (size_t v = 0; v < count; ++v) {
+        const float* p = vertices + v * stride;
+        for (int c = 0; c < 3; ++c) {
+            min[c] = std::min(min[c], p[c]);
+            max[c] = std::max(max[c], p[c]);
+        }
+    }
+}
+
+// --- Płaszczyzny z macierzy clip = projekcja * widok * model (Gribb, Hartmann), znormalizowane ---
+inline void ExtractFrustumPlanes(const glm::mat4& clip, FrustumPlanes& planes) {
+    for (int p = 0; p < 6; ++p) {
+        const int axis = p / 2;
+        const float sign = (p % 2 == 0) ? 1.0f : -1.0f;
+        // Wiersz 3 +/- wiersz osi (glm jest kolumnowy: element (wiersz r, kolumna k) to clip[k][r])
+        float plane[4];
+        for (int k = 0; k < 4; ++k) plane[k] = clip[k][3] + sign * clip[k][axis];
+        const float length = std::sqrt(plane[0] * plane[0] + plane[1] * plane[1] + plane[2] * plane[2]);
+        const float inv = (length > 0.0f) ? 1.0f / length : 0.0f;
+        planes.a[p] = plane[0] * inv;
+        planes.b[p] = plane[1] * inv;
+        planes.c[p] = plane[2] * inv;
+        planes.d[p] = plane[3] * inv;
+    }
+}
+
+// --- Sfera opisana na AABB przeniesionym macierzą world (Arvo: |M| * półprzekątna) ---
+inline void TransformBounds(const glm::mat4& world, const glm::vec3& min, const glm::vec3& max, glm::vec3& center,
+                            float& radius) {
+    const glm::vec3 localCenter = (min + max) * 0.5f;
+    const glm::vec3 half = (max - min) * 0.5f;
+    center = glm::vec3(world * glm::vec4(localCenter, 1.0f));
+    glm::vec3 extent;
+    for (int r = 0; r < 3; ++r) {
+        extent[r] = std::abs(world[0][r]) * half.x + std::abs(world[1][r]) * half.y + std::abs(world[2][r]) * half.z;
+    }
+    radius = std::sqrt(extent.x * extent.x + extent.y * extent.y + extent.z * extent.z);
+}
+
+namespace frustum_detail {
+
+inline void TestSpheresScalar(const FrustumPlanes& planes, const BoundingSpheres& spheres, size_t first, uint8_t* visible) {
+    for (size_t i = first; i < spheres.count; ++i) {
+        bool inside = true;
+        for (int p = 0; p < 6; ++p) {
+            const float distance = planes.a[p] * spheres.x[i] + planes.b[p] * spheres.y[i] + planes.c[p] * spheres.z[i] + planes.d[p];
+            inside = inside && distance >= -spheres.radius[i];
+        }
+        visible[i] = inside;
+    }
+}
+
+#if defined(FRUSTUM_SSE2)
+inline void TestSpheres(const FrustumPlanes& planes, const BoundingSpheres& spheres, uint8_t* visible) {
+    const size_t blocks = spheres.count / 4;
+    for (size_t block = 0; block < blocks; ++block) {
+        const size_t i = block * 4;
+        const __m128 x = _mm_loadu_ps(&spheres.x[i]), y = _mm_loadu_ps(&spheres.y[i]), z = _mm_loadu_ps(&spheres.z[i]);
+        const __m128 negRadius = _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(&spheres.radius[i]));
+        __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        for (int p = 0; p < 6; ++p) {
+            __m128 distance = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(planes.a[p]), x), _mm_mul_ps(_mm_set1_ps(planes.b[p]), y));
+            distance = _mm_add_ps(distance, _mm_add_ps(_mm_mul_ps(_mm_set1_ps(planes.c[p]), z), _mm_set1_ps(planes.d[p])));
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(distance, negRadius));
+        }
+        const int mask = _mm_movemask_ps(inside);
+        for (int k = 0; k < 4; ++k) visible[i + k] = (mask >> k) & 1;
+    }
+    TestSpheresScalar(planes, spheres, blocks * 4, visible);
+}
+#elif defined(FRUSTUM_WASM_SIMD)
+inline void TestSpheres(const FrustumPlanes& planes, const BoundingSpheres& spheres, uint8_t* visible) {
+    const size_t blocks = spheres.count / 4;
+    for (size_t block = 0; block < blocks; ++block) {
+        const size_t i = block * 4;
+        const v128_t x = wasm_v128_load(&spheres.x[i]), y = wasm_v128_load(&spheres.y[i]), z = wasm_v128_load(&spheres.z[i]);
+        const v128_t negRadius = wasm_f32x4_neg(wasm_v128_load(&spheres.radius[i]));
+        v128_t inside = wasm_i32x4_splat(-1);
+        for (int p = 0; p < 6; ++p) {
+            v128_t distance = wasm_f32x4_add(wasm_f32x4_mul(wasm_f32x4_splat(planes.a[p]), x),
+                                             wasm_f32x4_mul(wasm_f32x4_splat(planes.b[p]), y));
+            distance = wasm_f32x4_add(distance, wasm_f32x4_add(wasm_f32x4_mul(wasm_f32x4_splat(planes.c[p]), z),
+                                                               wasm_f32x4_splat(planes.d[p])));
+            inside = wasm_v128_and(inside, wasm_f32x4_ge(distance, negRadius));
+        }
+        const int mask = (int)wasm_i32x4_bitmask(inside);
+        for (int k = 0; k < 4; ++k) visible[i + k] = (mask >> k) & 1;
+    }
+    TestSpheresScalar(planes, spheres, blocks * 4, visible);
+}
+#else
+inline void TestSpheres(const FrustumPlanes& planes, const BoundingSpheres& spheres, uint8_t* visible) {
+    TestSpheresScalar(planes, spheres, 0, visible);
+}
+#endif
+
+}  // namespace frustum_detail
+
+// --- Widoczność każdej sfery (1 = przecina ostrosłup albo leży w nim); zwraca liczbę widocznych ---
+template <bool kSimd = true>
+inline size_t CullSpheres(const FrustumPlanes& planes, const BoundingSpheres& spheres, std::vector<uint8_t>& visible) {
+    visible.resize(spheres.count);
+    if (kSimd) {
+        frustum_detail::TestSpheres(planes, spheres, visible.data());
+    } else {
+        frustum_detail::TestSpheresScalar(planes, spheres, 0, visible.data());
+    }
+    size_t count = 0;
+    for (size_t i = 0; i < spheres.count; ++i) count += visible[i];
+    return count;
+}
+
+#endif  // FRUSTUM_H_
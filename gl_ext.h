@@ -0,0 +1,117 @@
+// Rozszerzenia GLES2 / WebGL1 wykrywane w czasie działania.
+// Wskaźniki do funkcji pobiera loader dostarczony przez program
+// (SDL_GL_GetProcAddress w przeglądarce, eglGetProcAddress w benchmarku).
+#ifndef GL_EXT_H_
+#define GL_EXT_H_
+
+#include <GLES2/gl2.h>
+#include <GLES2/gl2ext.h>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+using GLProcLoader = void* (*)(const char* name);
+
+struct GLExtensions {
+    // OES_vertex_array_object
+    bool vertexArrayObject = false;
+    PFNGLGENVERTEXARRAYSOESPROC genVertexArrays = nullptr;
+    PFNGLBINDVERTEXARRAYOESPROC bindVertexArray = nullptr;
+    PFNGLDELETEVERTEXARRAYSOESPROC deleteVertexArrays = nullptr;
+
+    // OES_element_index_uint - glDrawElements z GL_UNSIGNED_INT
+    bool elementIndexUint = false;
+
+    // ANGLE_instanced_arrays (WebGL1); natywnie EXT_instanced_arrays albo rdzeń GLES 3.0
+    bool instancedArrays = false;
+    PFNGLDRAWELEMENTSINSTANCEDANGLEPROC drawElementsInstanced = nullptr;
+    PFNGLVERTEXATTRIBDIVISORANGLEPROC vertexAttribDivisor = nullptr;
+
+    // EXT_texture_compression_s3tc / WEBGL_compressed_texture_s3tc (DXT1 i DXT5)
+    bool textureS3TC = false;
+    // OES_compressed_ETC1_RGB8_texture / WEBGL_compressed_texture_etc1
+    bool textureETC1 = false;
+
+    // EXT_disjoint_timer_query - czas GPU (GL_TIME_ELAPSED_EXT)
+    bool timerQuery = false;
+    PFNGLGENQUERIESEXTPROC genQueries = nullptr;
+    PFNGLDELETEQUERIESEXTPROC deleteQueries = nullptr;
+    PFNGLBEGINQUERYEXTPROC beginQuery = nullptr;
+    PFNGLENDQUERYEXTPROC endQuery = nullptr;
+    PFNGLGETQUERYOBJECTUIVEXTPROC getQueryObjectuiv = nullptr;
+    PFNGLGETQUERYOBJECTUI64VEXTPROC getQueryObjectui64v = nullptr;
+};
+
+inline GLExtensions glExt;
+
+// --- Czy nazwa występuje w GL_EXTENSIONS (całe słowo, nie prefiks) ---
+inline bool HasGLExtension(const char* name) {
+    const char* extensions = reinterpret_cast<const char*>(glGetString(GL_EXTENSIONS));
+    if (!extensions) return false;
+
+    const size_t len = std::strlen(name);
+    for (const char* p = std::strstr(extensions, name); p; p = std::strstr(p + len, name)) {
+        bool startOk = (p == extensions) || (p[-1] == ' ');
+        bool endOk = (p[len] == '\0') || (p[len] == ' ');
+        if (startOk && endOk) return true;
+    }
+    return false;
+}
+
+// --- Wymaga aktywnego kontekstu GL ---
+inline void LoadGLExtensions(GLProcLoader getProcAddress) {
+    glExt = GLExtensions();
+
+    if (getProcAddress && HasGLExtension("GL_OES_vertex_array_object")) {
+        glExt.genVertexArrays = reinterpret_cast<PFNGLGENVERTEXARRAYSOESPROC>(getProcAddress("glGenVertexArraysOES"));
+        glExt.bindVertexArray = reinterpret_cast<PFNGLBINDVERTEXARRAYOESPROC>(getProcAddress("glBindVertexArrayOES"));
+        glExt.deleteVertexArrays = reinterpret_cast<PFNGLDELETEVERTEXARRAYSOESPROC>(getProcAddress("glDeleteVertexArraysOES"));
+        glExt.vertexArrayObject = glExt.genVertexArrays && glExt.bindVertexArray && glExt.deleteVertexArrays;
+    }
+
+    glExt.elementIndexUint = HasGLExtension("GL_OES_element_index_uint");
+
+    // Te same sygnatury we wszystkich trzech wariantach - różni się tylko sufiks nazwy
+    const char* instancedSuffix = nullptr;
+    const char* version = reinterpret_cast<const char*>(glGetString(GL_VERSION));
+    if (HasGLExtension("GL_ANGLE_instanced_arrays")) {
+        instancedSuffix = "ANGLE";
+    } else if (HasGLExtension("GL_EXT_instanced_arrays")) {
+        instancedSuffix = "EXT";
+    } else if (version && std::strncmp(version, "OpenGL ES 3", 11) == 0) {
+        instancedSuffix = "";
+    }
+    if (getProcAddress && instancedSuffix) {
+        std::string draw = std::string("glDrawElementsInstanced") + instancedSuffix;
+        std::string divisor = std::string("glVertexAttribDivisor") + instancedSuffix;
+        glExt.drawElementsInstanced = reinterpret_cast<PFNGLDRAWELEMENTSINSTANCEDANGLEPROC>(getProcAddress(draw.c_str()));
+        glExt.vertexAttribDivisor = reinterpret_cast<PFNGLVERTEXATTRIBDIVISORANGLEPROC>(getProcAddress(divisor.c_str()));
+        glExt.instancedArrays = glExt.drawElementsInstanced && glExt.vertexAttribDivisor;
+    }
+
+    // Emscripten zgłasza rozszerzenia WebGL z prefiksem "GL_"
+    glExt.textureS3TC = HasGLExtension("GL_EXT_texture_compression_s3tc") ||
+                        HasGLExtension("GL_WEBGL_compressed_texture_s3tc");
+    glExt.textureETC1 = HasGLExtension("GL_OES_compressed_ETC1_RGB8_texture") ||
+                        HasGLExtension("GL_WEBGL_compressed_texture_etc1");
+
+    if (getProcAddress && HasGLExtension("GL_EXT_disjoint_timer_query")) {
+        glExt.genQueries = reinterpret_cast<PFNGLGENQUERIESEXTPROC>(getProcAddress("glGenQueriesEXT"));
+        glExt.deleteQueries = reinterpret_cast<PFNGLDELETEQUERIESEXTPROC>(getProcAddress("glDeleteQueriesEXT"));
+        glExt.beginQuery = reinterpret_cast<PFNGLBEGINQUERYEXTPROC>(getProcAddress("glBeginQueryEXT"));
+        glExt.endQuery = reinterpret_cast<PFNGLENDQUERYEXTPROC>(getProcAddress("glEndQueryEXT"));
+        glExt.getQueryObjectuiv = reinterpret_cast<PFNGLGETQUERYOBJECTUIVEXTPROC>(getProcAddress("glGetQueryObjectuivEXT"));
+        glExt.getQueryObjectui64v = reinterpret_cast<PFNGLGETQUERYOBJECTUI64VEXTPROC>(getProcAddress("glGetQueryObjectui64vEXT"));
+        glExt.timerQuery = glExt.genQueries && glExt.deleteQueries && glExt.beginQuery && glExt.endQuery &&
+                           glExt.getQueryObjectuiv && glExt.getQueryObjectui64v;
+    }
+
+    std::cout << "OES_vertex_array_object: " << (glExt.vertexArrayObject ? "tak" : "nie") << std::endl;
+    std::cout << "OES_element_index_uint: " << (glExt.elementIndexUint ? "tak" : "nie") << std::endl;
+    std::cout << "Instancing: " << (glExt.instancedArrays ? (*instancedSuffix ? instancedSuffix : "GLES 3.0") : "nie") << std::endl;
+    std::cout << "Kompresja tekstur: S3TC " << (glExt.textureS3TC ? "tak" : "nie") << ", ETC1 "
+              << (glExt.textureETC1 ? "tak" : "nie") << std::endl;
+    std::cout << "EXT_disjoint_timer_query: " << (glExt.timerQuery ? "tak" : "nie") << std::endl;
+}
+
+#endif  // GL_EXT_H_
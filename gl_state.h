@@ -0,0 +1,149 @@
+// Śledzenie stanu GL przed wywołaniami bind/use/uniform: powtórzone wywołania
+// z tą samą wartością są pomijane (w WebGL każde wywołanie to przejście do JS).
+// Liczniki issued/skipped pozwalają zmierzyć, ile wywołań faktycznie oszczędzamy.
+#ifndef GL_STATE_H_
+#define GL_STATE_H_
+
+#include <GLES2/gl2.h>
+#include <cstring>
+#include <map>
+#include <utility>
+
+#include "gl_ext.h"
+
+struct GLStateCounters {
+    unsigned long issued = 0;
+    unsigned long skipped = 0;
+};
+
+class GLStateCache {
+public:
+    static const GLuint kUnknown = ~0u; // Stan nieznany - następne wywołanie zawsze trafia do GL
+
+    void UseProgram(GLuint program) {
+        if (!Changed(program_, program)) return;
+        glUseProgram(program);
+    }
+
+    void BindBuffer(GLenum target, GLuint buffer) {
+        GLuint& bound = (target == GL_ELEMENT_ARRAY_BUFFER) ? elementArrayBuffer_ : arrayBuffer_;
+        if (!Changed(bound, buffer)) return;
+        glBindBuffer(target, buffer);
+    }
+
+    // EBO jest częścią stanu VAO, więc po zmianie VAO nie wiemy, co jest zbindowane
+    void BindVertexArray(GLuint vao) {
+        if (!Changed(vertexArray_, vao)) return;
+        glExt.bindVertexArray(vao);
+        elementArrayBuffer_ = kUnknown;
+    }
+
+    void ActiveTexture(GLenum unit) {
+        if (!Changed(activeTexture_, unit)) return;
+        glActiveTexture(unit);
+    }
+
+    void BindTexture(GLenum target, GLuint texture) {
+        GLuint unit = activeTexture_ - GL_TEXTURE0;
+        if (target != GL_TEXTURE_2D || activeTexture_ == kUnknown || unit >= kMaxTextureUnits) {
+            Issue();
+            glBindTexture(target, texture);
+            return;
+        }
+        if (!Changed(texture2D_[unit], texture)) return;
+        glBindTexture(target, texture);
+    }
+
+    // Wartości uniformów są stanem programu - klucz to (program, lokalizacja)
+    void Uniform1i(GLint location, GLint value) {
+        if (location < 0) return;
+        if (!UniformChanged(location, &value, sizeof(value))) return;
+        glUniform1i(location, value);
+    }
+
+    void Uniform1f(GLint location, GLfloat value) {
+        if (location < 0) return;
+        if (!UniformChanged(location, &value, sizeof(value))) return;
+        glUniform1f(location, value);
+    }
+
+    void Uniform3fv(GLint location, const GLfloat* value) {
+        if (location < 0) return;
+        if (!UniformChanged(location, value, 3 * sizeof(GLfloat))) return;
+        glUniform3fv(location, 1, value);
+    }
+
+    void Uniform4fv(GLint location, const GLfloat* value) {
+        if (location < 0) return;
+        if (!UniformChanged(location, value, 4 * sizeof(GLfloat))) return;
+        glUniform4fv(location, 1, value);
+    }
+
+    void UniformMatrix3fv(GLint location, const GLfloat* value) {
+        if (location < 0) return;
+        if (!UniformChanged(location, value, 9 * sizeof(GLfloat))) return;
+        glUniformMatrix3fv(location, 1, GL_FALSE, value);
+    }
+
+    void UniformMatrix4fv(GLint location, const GLfloat* value) {
+        if (location < 0) return;
+        if (!UniformChanged(location, value, 16 * sizeof(GLfloat))) return;
+        glUniformMatrix4fv(location, 1, GL_FALSE, value);
+    }
+
+    // Po operacjach omijających cache (glDelete*, kod zewnętrzny) albo zmianie kontekstu
+    void Invalidate() {
+        program_ = arrayBuffer_ = elementArrayBuffer_ = vertexArray_ = activeTexture_ = kUnknown;
+        for (auto& texture : texture2D_) texture = kUnknown;
+        uniforms_.clear();
+    }
+
+    const GLStateCounters& Counters() const { return counters_; }
+    void ResetCounters() { counters_ = GLStateCounters(); }
+
+private:
+    static const GLuint kMaxTextureUnits = 8;
+
+    struct UniformValue {
+        unsigned char bytes[16 * sizeof(GLfloat)];
+        size_t size;
+    };
+
+    bool Changed(GLuint& current, GLuint value) {
+        if (current == value) {
+            ++counters_.skipped;
+            return false;
+        }
+        current = value;
+        Issue();
+        return true;
+    }
+
+    bool UniformChanged(GLint location, const void* value, size_t size) {
+        UniformValue& cached = uniforms_[std::make_pair(program_, location)];
+        if (cached.size == size && std::memcmp(cached.bytes, value, size) == 0) {
+            ++counters_.skipped;
+            return false;
+        }
+        std::memcpy(cached.bytes, value, size);
+        cached.size = size;
+        Issue();
+        return true;
+    }
+
+    void Issue() { ++counters_.issued; }
+
+    GLuint program_ = kUnknown;
+    GLuint arrayBuffer_ = kUnknown;
+    GLuint elementArrayBuffer_ = kUnknown;
+    GLuint vertexArray_ = kUnknown;
+    GLuint activeTexture_ = kUnknown;
+    GLuint texture2D_[kMaxTextureUnits] = {kUnknown, kUnknown, kUnknown, kUnknown,
+                                           kUnknown, kUnknown, kUnknown, kUnknown};
+    std::map<std::pair<GLuint, GLint>, UniformValue> uniforms_;
+    GLStateCounters counters_;
+};
+
+inline GLStateCache glState;
+
+#endif  // GL_STATE_H_
@@ -0,0 +1,66 @@
+// Kontekst GLES2 bez okna dla natywnych benchmarków: pbuffer EGL
+// (np. Mesa llvmpipe na platformie surfaceless, bez X11/Wayland).
+#ifndef HEADLESS_EGL_H_
+#define HEADLESS_EGL_H_
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#include <GLES2/gl2.h>
+
+#include <iostream>
+
+inline EGLDisplay eglDisplay = EGL_NO_DISPLAY;
+inline EGLSurface eglSurface = EGL_NO_SURFACE;
+
+// --- Kontekst GLES2 z powierzchnią pbuffer width x height ---
+inline bool CreateHeadlessContext(int width, int height) {
+    // Najpierw platforma surfaceless (nie potrzebuje X11/Wayland), potem domyślny wyświetlacz
+    auto getPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(
+        eglGetProcAddress("eglGetPlatformDisplayEXT"));
+    if (getPlatformDisplay) {
+        eglDisplay = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+    }
+    if (eglDisplay == EGL_NO_DISPLAY || !eglInitialize(eglDisplay, nullptr, nullptr)) {
+        eglDisplay = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+        if (eglDisplay == EGL_NO_DISPLAY || !eglInitialize(eglDisplay, nullptr, nullptr)) {
+            std::cerr << "EGL init failed: 0x" << std::hex << eglGetError() << std::endl;
+            return false;
+        }
+    }
+
+    const EGLint configAttribs[] = {
+        EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+        EGL_RENDERABLE_TYPE, EGL_OPENGL_ES2_BIT,
+        EGL_RED_SIZE, 8, EGL_GREEN_SIZE, 8, EGL_BLUE_SIZE, 8,
+        EGL_DEPTH_SIZE, 16,
+        EGL_NONE
+    };
+    EGLConfig config;
+    EGLint numConfigs = 0;
+    if (!eglChooseConfig(eglDisplay, configAttribs, &config, 1, &numConfigs) || numConfigs == 0) {
+        std::cerr << "EGL: brak konfiguracji GLES2 z pbufferem" << std::endl;
+        return false;
+    }
+
+    eglBindAPI(EGL_OPENGL_ES_API);
+    const EGLint contextAttribs[] = { EGL_CONTEXT_CLIENT_VERSION, 2, EGL_NONE };
+    EGLContext context = eglCreateContext(eglDisplay, config, EGL_NO_CONTEXT, contextAttribs);
+    const EGLint surfaceAttribs[] = { EGL_WIDTH, width, EGL_HEIGHT, height, EGL_NONE };
+    eglSurface = eglCreatePbufferSurface(eglDisplay, config, surfaceAttribs);
+    if (context == EGL_NO_CONTEXT || eglSurface == EGL_NO_SURFACE ||
+        !eglMakeCurrent(eglDisplay, eglSurface, eglSurface, context)) {
+        std::cerr << "EGL: nie udalo sie utworzyc kontekstu: 0x" << std::hex << eglGetError() << std::endl;
+        return false;
+    }
+
+    std::cout << "GL_RENDERER: " << glGetString(GL_RENDERER) << std::endl;
+    std::cout << "GL_VERSION: " << glGetString(GL_VERSION) << std::endl;
+    return true;
+}
+
+// Loader wskaźników funkcji rozszerzeń GL dla renderer.h
+inline void* GetGLProcAddress(const char* name) {
+    return reinterpret_cast<void*>(eglGetProcAddress(name));
+}
+
+#endif  // HEADLESS_EGL_H_
@@ -0,0 +1,61 @@
+// Zużycie sterty (malloc) do porównania szczytu przy ładowaniu ze stanem ustalonym.
+// W przeglądarce (ALLOW_MEMORY_GROWTH) pamięć wasm rośnie do szczytu i nigdy nie
+// maleje - "zarezerwowane" to rozmiar sterty wasm, "w użyciu" to zajęte bloki dlmalloc.
+// Szczyt "w użyciu" jest próbkowany w punktach ładowania (SampleHeap).
+#ifndef HEAP_USAGE_H_
+#define HEAP_USAGE_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+
+#if defined(__EMSCRIPTEN__)
+#include <emscripten/heap.h>
+#include <malloc.h>
+#elif defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+struct HeapUsage {
+    size_t inUse = 0;    // Bajty zajęte przez malloc
+    size_t reserved = 0; // Bajty pobrane od systemu / rozmiar sterty wasm
+};
+
+inline HeapUsage CurrentHeapUsage() {
+    HeapUsage usage;
+#if defined(__EMSCRIPTEN__)
+    struct mallinfo info = mallinfo();
+    usage.inUse = (size_t)info.uordblks;
+    usage.reserved = emscripten_get_heap_size();
+#elif defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    struct mallinfo2 info = mallinfo2();
+    usage.inUse = info.uordblks + info.hblkhd; // hblkhd: duże bloki przydzielane przez mmap
+    usage.reserved = info.arena + info.hblkhd;
+#endif
+    return usage;
+}
+
+// Szczyt od ostatniego ResetHeapPeak (maksimum z próbek)
+inline HeapUsage heapPeak;
+
+inline void ResetHeapPeak() { heapPeak = CurrentHeapUsage(); }
+
+inline void SampleHeap() {
+    HeapUsage now = CurrentHeapUsage();
+    heapPeak.inUse = std::max(heapPeak.inUse, now.inUse);
+    heapPeak.reserved = std::max(heapPeak.reserved, now.reserved);
+}
+
+// --- Raport szczyt / stan ustalony (MB) ---
+inline void PrintHeapReport(const char* label) {
+    SampleHeap();
+    HeapUsage now = CurrentHeapUsage();
+    const double mb = 1.0 / (1024.0 * 1024.0);
+    std::cout << std::fixed << std::setprecision(1) << "Sterta (" << label << "): w uzyciu " << now.inUse * mb
+              << " MB (szczyt " << heapPeak.inUse * mb << " MB), zarezerwowane " << now.reserved * mb
+              << " MB (szczyt " << heapPeak.reserved * mb << " MB)" << std::endl;
+    std::cout.unsetf(std::ios_base::floatfield);
+}
+
+#endif  // HEAP_USAGE_H_
@@ -0,0 +1,132 @@
+// Profil etapów ładowania modelu: sondy LOAD_PROFILE_SCOPE("nazwa") mierzą czas
+// zakresu (RAII) i zapisują go do loadProfiler - z podsumowaniem (liczba wywołań,
+// suma, maksimum, udział w czasie sesji) i śladem Chrome Trace (chrome_trace.h).
+// Sesja zaczyna się w LoadGLB (Reset) i obejmuje też dekodowanie tekstur i mipmapy.
+//
+// Sondy w tinygltf (odczyt pliku, parsowanie JSON, base64, LoadImageData) idą przez
+// makro TINYGLTF_PROFILE_SCOPE, które tiny_gltf.cc ustawia na LOAD_PROFILE_SCOPE.
+// Zapis jest chroniony mutexem - LoadImageData i mipmapy działają na innych wątkach.
+//
+// Budowa z -DLOAD_PROFILING=0 usuwa wszystkie sondy (makro rozwija się do niczego).
+#ifndef LOAD_PROFILER_H_
+#define LOAD_PROFILER_H_
+
+#ifndef LOAD_PROFILING
+#define LOAD_PROFILING 1
+#endif
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "chrome_trace.h"
+
+class LoadProfiler {
+public:
+    // --- Nowa sesja (poprzednie pomiary i ślad są kasowane) ---
+    void Reset() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats_.clear();
+        threads_.clear();
+        trace_ = ChromeTrace();
+        trace_.Start();
+        reported_ = false;
+    }
+
+    void Record(const char* name, double startUs, double durationUs) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto inserted = threads_.emplace(std::this_thread::get_id(), (int)threads_.size() + 1);
+        const int tid = inserted.first->second;
+        if (inserted.second) {
+            trace_.ThreadName(tid, tid == 1 ? "ladowanie" : ("watek " + std::to_string(tid)).c_str());
+        }
+        trace_.Complete(name, "load", startUs, durationUs, tid);
+
+        Stat& stat = stats_[name];
+        if (stat.count == 0) stat.firstStartUs = startUs;
+        ++stat.count;
+        stat.totalUs += durationUs;
+        stat.maxUs = std::max(stat.maxUs, durationUs);
+        stat.endUs = std::max(stat.endUs, startUs + durationUs);
+    }
+
+    bool Empty() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return stats_.empty();
+    }
+    bool Reported() const { return reported_; }
+
+    // --- Tabela etapów w kolejności pierwszego wystąpienia ---
+    // Etapy zagnieżdżone (np. LoadImageData w LoadFromString) nakładają się, więc procenty nie sumują się do 100.
+    void PrintSummary(std::ostream& out) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        reported_ = true;
+        if (stats_.empty()) return;
+
+        std::vector<std::pair<std::string, Stat>> rows(stats_.begin(), stats_.end());
+        std::sort(rows.begin(), rows.end(),
+                  [](const auto& a, const auto& b) { return a.second.firstStartUs < b.second.firstStartUs; });
+        double begin = rows.front().second.firstStartUs, end = begin;
+        for (const auto& row : rows) end = std::max(end, row.second.endUs);
+        const double wallUs = std::max(end - begin, 1.0);
+
+        out << "Profil ladowania: " << std::fixed << std::setprecision(2) << wallUs / 1000.0 << " ms od pierwszej sondy\n";
+        out << std::left << std::setw(44) << "etap" << std::right << std::setw(8) << "wywol" << std::setw(11) << "suma ms"
+            << std::setw(10) << "max ms" << std::setw(8) << "%" << "\n";
+        for (const auto& row : rows) {
+            out << std::left << std::setw(44) << row.first << std::right << std::setw(8) << row.second.count
+                << std::setw(11) << row.second.totalUs / 1000.0 << std::setw(10) << row.second.maxUs / 1000.0
+                << std::setw(8) << std::setprecision(1) << 100.0 * row.second.totalUs / wallUs << std::setprecision(2)
+                << "\n";
+        }
+        out.unsetf(std::ios_base::floatfield);
+    }
+
+    bool WriteTrace(const std::string& path) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return trace_.Write(path);
+    }
+
+private:
+    struct Stat {
+        size_t count = 0;
+        double totalUs = 0, maxUs = 0;
+        double firstStartUs = 0, endUs = 0;
+    };
+
+    mutable std::mutex mutex_;
+    std::map<std::string, Stat> stats_;
+    std::map<std::thread::id, int> threads_;
+    ChromeTrace trace_;
+    bool reported_ = false;
+};
+
+inline LoadProfiler loadProfiler;
+
+// Sonda zakresu: czas od konstrukcji do końca bloku
+class LoadProbe {
+public:
+    explicit LoadProbe(const char* name) : name_(name), startUs_(TraceNowUs()) {}
+    ~LoadProbe() { loadProfiler.Record(name_, startUs_, TraceNowUs() - startUs_); }
+    LoadProbe(const LoadProbe&) = delete;
+    LoadProbe& operator=(const LoadProbe&) = delete;
+
+private:
+    const char* name_;
+    double startUs_;
+};
+
+#if LOAD_PROFILING
+#define LOAD_PROFILE_CONCAT_(a, b) a##b
+#define LOAD_PROFILE_CONCAT(a, b) LOAD_PROFILE_CONCAT_(a, b)
+#define LOAD_PROFILE_SCOPE(name) LoadProbe LOAD_PROFILE_CONCAT(loadProbe_, __LINE__)(name)
+#else
+#define LOAD_PROFILE_SCOPE(name) ((void)0)
+#endif
+
+#endif  // LOAD_PROFILER_H_
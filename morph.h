@@ -0,0 +1,162 @@
+// Morph targety (blend shapes) liczone na CPU. Każdy target trzyma tylko wierzchołki
+// z niezerową deltą POSITION / NORMAL - indeks i 8 floatów w układzie Vertex
+// (pozycja, normalna, 0, 0), więc dodanie delty to dwa 4-pasmowe mnożenia z dodawaniem
+// (SSE2 / WASM SIMD128, wersja skalarna jako referencja).
+//
+// Po zmianie wag przeliczany jest tylko zakres wierzchołków targetów, których waga
+// się zmieniła: kopia bazy i suma targetów z niezerową wagą w tym zakresie. Zakres
+// wraca do wywołującego, który wysyła go do VBO jednym glBufferSubData.
+// Shader z deltami jako atrybutami odpada - GLES2 gwarantuje tylko 8 atrybutów, z czego
+// 7 zajmują pozycja, normalna, UV i a_instance.
+#ifndef MORPH_H_
+#define MORPH_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "accessor_reader.h"
+#include "tiny_gltf.h"
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define MORPH_SSE2 1
+#elif defined(__wasm_simd128__)
+#include <wasm_simd128.h>
+#define MORPH_WASM_SIMD 1
+#endif
+
+struct MorphTarget {
+    std::vector<uint32_t> vertices; // Rosnąco
+    std::vector<float> deltas;      // 8 floatów na wpis, układ jak Vertex
+    uint32_t first = 0, last = 0;   // Zakres wierzchołków [first, last]
+};
+
+struct MorphMesh {
+    std::vector<float> base;    // Wierzchołki bez morphingu (8 floatów, jak Vertex)
+    std::vector<float> current; // Wynik dla applied
+    std::vector<MorphTarget> targets;
+    std::vector<float> applied; // Wagi, dla których policzono current
+
+    size_t VertexCount() const { return base.size() / 8; }
+};
+
+// --- Rzadkie delty targetów prymitywu; false, gdy prymityw nie ma targetów ---
+inline bool ReadMorphTargets(const tinygltf::Model& model, const tinygltf::Primitive& primitive, size_t vertexCount,
+                             std::vector<MorphTarget>& targets) {
+    targets.assign(primitive.targets.size(), MorphTarget());
+    bool any = false;
+    for (size_t t = 0; t < primitive.targets.size(); ++t) {
+        std::vector<float> streams[2]; // POSITION, NORMAL
+        const char* names[2] = {"POSITION", "NORMAL"};
+        for (int a = 0; a < 2; ++a) {
+            auto it = primitive.targets[t].find(names[a]);
+            if (it == primitive.targets[t].end() || it->second < 0 || it->second >= (int)model.accessors.size()) continue;
+            if (!ReadAccessor(model, model.accessors[it->second], streams[a], 3) || streams[a].size() != vertexCount * 3) {
+                streams[a].clear();
+            }
+        }
+        MorphTarget& target = targets[t];
+        for (size_t v = 0; v < vertexCount; ++v) {
+            float delta[8] = {};
+            bool nonZero = false;
+            for (int a = 0; a < 2; ++a) {
+                if (streams[a].empty()) continue;
+                for (int c = 0; c < 3; ++c) {
+                    delta[a * 3 + c] = streams[a][v * 3 + c];
+                    nonZero = nonZero || delta[a * 3 + c] != 0.0f;
+                }
+            }
+            if (!nonZero) continue;
+            target.vertices.push_back((uint32_t)v);
+            target.deltas.insert(target.deltas.end(), delta, delta + 8);
+        }
+        if (!target.vertices.empty()) {
+            target.first = target.vertices.front();
+            target.last = target.vertices.back();
+            any = true;
+        }
+    }
+    return any;
+}
+
+inline bool MeshHasMorphTargets(const tinygltf::Mesh& mesh) {
+    for (const auto& primitive : mesh.primitives) {
+        if (!primitive.targets.empty()) return true;
+    }
+    return false;
+}
+
+inline bool HasMorphTargets(const tinygltf::Model& model) {
+    for (const auto& mesh : model.meshes) {
+        if (MeshHasMorphTargets(mesh)) return true;
+    }
+    return false;
+}
+
+namespace morph_detail {
+
+inline void AddScaledScalar(float* vertex, const float* delta, float weight) {
+    for (int i = 0; i < 8; ++i) vertex[i] += weight * delta[i];
+}
+
+#if defined(MORPH_SSE2)
+inline void AddScaled(float* vertex, const float* delta, float weight) {
+    const __m128 w = _mm_set1_ps(weight);
+    _mm_storeu_ps(vertex, _mm_add_ps(_mm_loadu_ps(vertex), _mm_mul_ps(w, _mm_loadu_ps(delta))));
+    _mm_storeu_ps(vertex + 4, _mm_add_ps(_mm_loadu_ps(vertex + 4), _mm_mul_ps(w, _mm_loadu_ps(delta + 4))));
+}
+#elif defined(MORPH_WASM_SIMD)
+inline void AddScaled(float* vertex, const float* delta, float weight) {
+    const v128_t w = wasm_f32x4_splat(weight);
+    wasm_v128_store(vertex, wasm_f32x4_add(wasm_v128_load(vertex), wasm_f32x4_mul(w, wasm_v128_load(delta))));
+    wasm_v128_store(vertex + 4, wasm_f32x4_add(wasm_v128_load(vertex + 4), wasm_f32x4_mul(w, wasm_v128_load(delta + 4))));
+}
+#else
+inline void AddScaled(float* vertex, const float* delta, float weight) { AddScaledScalar(vertex, delta, weight); }
+#endif
+
+}  // namespace morph_detail
+
+// --- Przeliczenie current dla nowych wag (weightCount może być mniejsze niż liczba targetów) ---
+// Zwraca false, gdy żadna waga się nie zmieniła; w przeciwnym razie [begin, end) to zmienione wierzchołki.
+template <bool kSimd = true>
+inline bool EvaluateMorph(MorphMesh& morph, const float* weights, size_t weightCount, uint32_t& begin, uint32_t& end) {
+    const size_t targetCount = morph.targets.size();
+    if (morph.applied.size() != targetCount) {
+        morph.applied.assign(targetCount, 0.0f);
+        morph.current = morph.base;
+    }
+    begin = UINT32_MAX;
+    end = 0;
+    for (size_t t = 0; t < targetCount; ++t) {
+        const float weight = t < weightCount ? weights[t] : 0.0f;
+        const MorphTarget& target = morph.targets[t];
+        if (weight == morph.applied[t] || target.vertices.empty()) continue;
+        begin = std::min(begin, target.first);
+        end = std::max(end, target.last + 1);
+    }
+    if (begin >= end) return false;
+
+    std::memcpy(morph.current.data() + (size_t)begin * 8, morph.base.data() + (size_t)begin * 8,
+                (size_t)(end - begin) * 8 * sizeof(float));
+    for (size_t t = 0; t < targetCount; ++t) {
+        const float weight = t < weightCount ? weights[t] : 0.0f;
+        morph.applied[t] = weight;
+        const MorphTarget& target = morph.targets[t];
+        if (weight == 0.0f || target.last < begin || target.first >= end) continue; // Zerowe wagi nic nie dodają
+        size_t i = std::lower_bound(target.vertices.begin(), target.vertices.end(), begin) - target.vertices.begin();
+        for (; i < target.vertices.size() && target.vertices[i] < end; ++i) {
+            float* vertex = morph.current.data() + (size_t)target.vertices[i] * 8;
+            if (kSimd) {
+                morph_detail::AddScaled(vertex, target.deltas.data() + i * 8, weight);
+            } else {
+                morph_detail::AddScaledScalar(vertex, target.deltas.data() + i * 8, weight);
+            }
+        }
+    }
+    return true;
+}
+
+#endif  // MORPH_H_
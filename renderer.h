@@ -0,0 +1,1714 @@
+// Wspólna ścieżka renderowania GLB (GLES2 / WebGL1) dla przeglądarek (tc.cpp, tc2.cpp)
+// i natywnego benchmarku (bench_render.cpp). Nie zależy od SDL ani Emscripten -
+// okno, kontekst GL i pętlę zdarzeń dostarcza program, który ten plik dołącza.
+#ifndef RENDERER_H_
+#define RENDERER_H_
+
+#include <GLES2/gl2.h>
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "gl_ext.h"
+#include "accessor_reader.h"
+#include "animation.h"
+#include "attribute_gather.h"
+#include "frame_stats.h"
+#include "frustum.h"
+#include "gl_state.h"
+#include "heap_usage.h"
+#include "load_profiler.h"
+#include "morph.h"
+#include "scene_graph.h"
+#include "skinning.h"
+#include "texture_compression.h"
+#include "texture_mipmaps.h"
+#include "tiny_gltf.h"
+#include "vertex_quantization.h"
+#ifdef __EMSCRIPTEN__
+#include <emscripten.h>
+#endif
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+// --- Globalne zmienne do obracania modelem ---
+inline float rotX = 0, rotY = 0;
+
+struct Vertex {
+    glm::vec3 position;
+    glm::vec3 normal;
+    glm::vec2 texcoord;
+};
+static_assert(sizeof(Vertex) == 8 * sizeof(float), "GatherVertices zapisuje 8 floatow na wierzcholek");
+
+// Wskaźnik jednego atrybutu w buforze bufferView (bezpośredni upload, bez Vertex)
+struct VertexAttribGL {
+    GLuint buffer = 0; // 0 = brak atrybutu w prymitywie (tablica wyłączona, stała wartość)
+    GLint size = 0;
+    GLenum type = GL_FLOAT;
+    GLboolean normalized = GL_FALSE;
+    GLsizei stride = 0;
+    size_t offset = 0;
+};
+
+struct MeshGL {
+    GLuint vbo = 0;
+    GLuint ebo = 0;
+    GLuint vao = 0; // 0 gdy brak OES_vertex_array_object - atrybuty ustawiane co klatkę
+    GLsizei indexCount = 0;
+    GLenum indexType = GL_UNSIGNED_SHORT; // GL_UNSIGNED_BYTE / _SHORT / _INT (to ostatnie tylko z OES_element_index_uint)
+    glm::mat4 transform = glm::mat4(1.0f); // Macierz świata; jednostkowa, gdy wierzchołki są już przetransformowane
+    int node = -1; // Węzeł glTF dla meshy animowanych, -1 dla batchy
+    int material = -1;
+    int texture = -1; // Tekstura glTF bazowego koloru materiału (klucz ModelGL::textures), -1 = biała
+    std::vector<glm::mat4> instances; // Macierze świata węzłów współdzielących mesh; puste = jeden draw z transform
+    GLuint instanceVbo = 0; // Strumień macierzy per instancja (tylko z instancingiem sprzętowym)
+    bool quantized = false; // VBO z QuantizedVertex zamiast Vertex
+    QuantizationParams quantization;
+    // Bufory bufferView współdzielone z innymi prymitywami (w ModelGL) zamiast własnych vbo/ebo
+    bool direct = false;
+    VertexAttribGL attribs[3]; // position, normal, texcoord
+    size_t indexOffset = 0;    // Bajty od początku EBO (bufferView indeksów)
+    // Skinning: indeks w ModelGL::skins; GPU - strumień SkinVertex w skinVbo, CPU - wpis w ModelGL::cpuSkins
+    int skin = -1;
+    GLuint skinVbo = 0;
+    int cpuSkin = -1;
+    // AABB wierzchołków przed `transform` / instancjami; brak = nigdy nie odrzucany (skinning, morph targety)
+    bool hasBounds = false;
+    glm::vec3 boundsMin = glm::vec3(0.0f), boundsMax = glm::vec3(0.0f);
+};
+
+// Mesh skinowany na CPU: wierzchołki w pozie wiązania, przeliczane do VBO przy zmianie palety
+struct CpuSkinnedMesh {
+    int skin = -1;
+    GLuint vbo = 0;
+    std::vector<Vertex> bindVertices;
+    std::vector<SkinVertex> skinVertices;
+    std::vector<Vertex> skinned;
+    unsigned version = 0; // Wersja palety, z której policzono VBO
+};
+
+// Prymityw z morph targetami: wynik trafia do vbo albo (skinning CPU) do pozy wiązania w cpuSkins
+struct MorphMeshGL {
+    MorphMesh morph;
+    int node = -1; // Wagi z NodePose węzła; -1 = stałe wagi meshu
+    GLuint vbo = 0;
+    int cpuSkin = -1;
+};
+
+// Animacje modelu i hierarchia węzłów potrzebna do macierzy świata animowanych meshy
+struct ModelAnimation {
+    std::vector<AnimationClip> clips;
+    AnimationPlayer player;
+    NodePose pose;
+    SceneGraph graph;                // Macierze świata węzłów sceny (przeliczane tylko zmienione poddrzewa)
+    double lastUs = -1;              // Czas poprzedniego kroku (TraceNowUs)
+};
+
+struct ModelGL {
+    std::vector<MeshGL> meshes; // Posortowane po programie i teksturze (najmniej przełączeń)
+    // Indeks tekstury glTF -> tekstura GL, wspólna dla wszystkich prymitywów z tym indeksem.
+    // 0 = czeka na dekodowanie i upload przy pierwszym rysowaniu (LoadPendingTextures).
+    std::map<int, GLuint> textures;
+    bool texturesPending = false;
+    GLuint whiteTexture = 0; // Dla materiałów bez tekstury i tekstur, których nie udało się wczytać
+    std::map<int, GLuint> arrayViewBuffers;   // bufferView -> VBO (bezpośredni upload)
+    std::map<int, GLuint> elementViewBuffers; // bufferView -> EBO
+    ModelAnimation animation;
+    std::vector<SkinData> skins;
+    std::vector<CpuSkinnedMesh> cpuSkins;
+    std::vector<MorphMeshGL> morphs;
+    // Frustum culling (RenderFrame): sfery meshy i instancji, meshes[i] ma sfery od firstSphere[i]
+    BoundingSpheres spheres;
+    std::vector<uint32_t> firstSphere;
+    std::vector<uint8_t> visible;
+    // Przeglądarka: obrazy, dla których pobierano już .ctex (StartCompressedFetch), i pobierania w toku
+    std::set<int> compressedFetches;
+    int compressedFetchesInFlight = 0;
+};
+
+// Scalanie statycznych prymitywów o tym samym materiale przy ładowaniu (LoadModelToOpenGL)
+inline bool batchStaticMeshes = true;
+// Mesh użyty przez kilka statycznych węzłów rysowany raz na grupę (instancing) zamiast kopiowania do batcha
+inline bool instanceRepeatedMeshes = true;
+// VBO w formacie QuantizedVertex (16 bajtów) zamiast Vertex (32 bajty)
+inline bool quantizeVertices = false;
+// Niebatchowane prymitywy o układzie zgodnym z GL ładowane prosto z bufferView (jeden VBO na bufferView)
+inline bool uploadBufferViewsDirectly = true;
+// Zwalnianie buforów i obrazów gltfModel zaraz po utworzeniu obiektów GL (ReleaseModelBuffers / ReleaseModelImages)
+inline bool discardAfterUpload = false;
+// Odtwarzanie pierwszego klipu animacji modelu w pętli (false = pauza)
+inline bool playAnimations = true;
+// Odrzucanie meshy poza ostrosłupem widzenia przed draw callami
+inline bool frustumCulling = true;
+// Limit stawów skinningu GPU; 0 = z GL_MAX_VERTEX_UNIFORM_VECTORS. Skiny z większą liczbą stawów idą przez CPU
+inline int skinningJointLimit = 0;
+inline QuantizationReport quantizationReport; // Błąd kwantyzacji ostatnio wczytanego modelu
+inline size_t textureGpuBytes = 0; // Szacowana pamięć GPU tekstur ostatnio wczytanego modelu (z mipmapami)
+
+inline ModelGL myModel;
+inline tinygltf::Model gltfModel; // Globalny - obrazy (skompresowane) są dekodowane dopiero w RenderFrame
+
+// Lokalizacje atrybutów są wiązane przed linkowaniem - te same w obu programach,
+// więc VAO i SetupVertexAttributes nie zależą od wariantu shadera
+inline const GLint attrPositionLoc = 0;
+inline const GLint attrNormalLoc = 1;
+inline const GLint attrTexcoordLoc = 2;
+inline const GLint attrInstanceLoc = 3; // mat4 - zajmuje 4 kolejne lokalizacje (kolumny)
+// Wariant SKINNED nie ma a_instance (skinowane meshe nie są instancjonowane) - te same lokalizacje,
+// bo GLES2 gwarantuje tylko 8 atrybutów
+inline const GLint attrJointsLoc = 3;
+inline const GLint attrWeightsLoc = 4;
+inline bool instanceAttribDirty = true; // Stała wartość a_instance do odtworzenia po rysowaniu z tablicą
+
+struct ShaderGL {
+    GLuint program = 0;
+    GLint uniformMVPLoc = -1;
+    GLint uniformNormalMatrixLoc = -1;
+    GLint uniformTextureLoc = -1;
+    GLint uniformPositionScaleLoc = -1;  // Tylko wariant QUANTIZED
+    GLint uniformPositionOffsetLoc = -1;
+    GLint uniformTexcoordTransformLoc = -1;
+    GLint uniformJointsLoc = -1;         // Tylko wariant SKINNED
+};
+
+inline ShaderGL floatShader;     // Vertex (float)
+inline ShaderGL quantizedShader; // QuantizedVertex
+inline ShaderGL skinnedShader;   // Vertex + SkinVertex, paleta stawów w uniformach
+inline int gpuSkinJoints = 0;    // Rozmiar palety wariantu SKINNED (InitRenderer)
+// Paleta aktualnie wgrana do programu SKINNED (skin i wersja) - bez ponownego uploadu dla kolejnych meshy
+inline int uploadedPaletteSkin = -1;
+inline unsigned uploadedPaletteVersion = 0;
+
+// --- Kompilacja i tworzenie programu shaderowego ---
+inline GLuint CompileShader(GLenum type, const char* source) {
+    GLuint shader = glCreateShader(type);
+    glShaderSource(shader, 1, &source, nullptr);
+    glCompileShader(shader);
+
+    GLint compiled;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &compiled);
+    if (!compiled) {
+        char log[512];
+        glGetShaderInfoLog(shader, 512, nullptr, log);
+        std::cerr << "Shader compile error: " << log << std::endl;
+        glDeleteShader(shader);
+        return 0;
+    }
+    return shader;
+}
+
+// quantized = true kompiluje wariant z dekwantyzacją QuantizedVertex (#define QUANTIZED),
+// maxJoints > 0 - wariant SKINNED z paletą maxJoints stawów (3 x vec4 na staw)
+inline GLuint CreateShaderProgram(bool quantized, int maxJoints = 0) {
+    const char* vertexBody = R"(
+        attribute vec3 a_position;
+    #ifdef QUANTIZED
+        attribute vec2 a_normal; // Oktaedryczna, znormalizowana do [-1, 1]
+    #else
+        attribute vec3 a_normal;
+    #endif
+        attribute vec2 a_texcoord;
+    #ifdef SKINNED
+        attribute vec4 a_joints;
+        attribute vec4 a_weights;
+        uniform vec4 u_joints[MAX_JOINTS * 3]; // Wiersze 0..2 macierzy świata stawu
+
+        mat4 JointMatrix(float joint) {
+            int i = int(joint) * 3;
+            vec4 r0 = u_joints[i], r1 = u_joints[i + 1], r2 = u_joints[i + 2];
+            return mat4(r0.x, r1.x, r2.x, 0.0, r0.y, r1.y, r2.y, 0.0, r0.z, r1.z, r2.z, 0.0, r0.w, r1.w, r2.w, 1.0);
+        }
+    #else
+        attribute mat4 a_instance; // Per instancja albo stała jednostkowa
+    #endif
+
+        uniform mat4 u_mvp; // projection * view * obrót * model, liczone na CPU raz na draw
+        uniform mat3 u_normalMatrix; // Odwrotna-transponowana części 3x3 macierzy świata
+
+    #ifdef QUANTIZED
+        uniform vec3 u_positionScale; // Połowa AABB meshu
+        uniform vec3 u_positionOffset; // Środek AABB
+        uniform vec4 u_texcoordTransform; // xy skala, zw przesunięcie zakresu UV
+
+        vec3 OctDecode(vec2 e) {
+            vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+            float t = max(-n.z, 0.0);
+            n.xy += mix(vec2(t), vec2(-t), step(vec2(0.0), n.xy));
+            return normalize(n);
+        }
+    #endif
+
+        varying vec3 v_normal;
+        varying vec2 v_texcoord;
+
+        void main() {
+    #ifdef QUANTIZED
+            vec3 position = a_position * u_positionScale + u_positionOffset;
+            vec3 normal = OctDecode(a_normal);
+            vec2 texcoord = a_texcoord * u_texcoordTransform.xy + u_texcoordTransform.zw;
+    #else
+            vec3 position = a_position;
+            vec3 normal = a_normal;
+            vec2 texcoord = a_texcoord;
+    #endif
+    #ifdef SKINNED
+            mat4 world = a_weights.x * JointMatrix(a_joints.x) + a_weights.y * JointMatrix(a_joints.y) +
+                         a_weights.z * JointMatrix(a_joints.z) + a_weights.w * JointMatrix(a_joints.w);
+    #else
+            mat4 world = a_instance;
+    #endif
+            gl_Position = u_mvp * world * vec4(position, 1.0);
+            v_normal = u_normalMatrix * mat3(world) * normal;
+            v_texcoord = texcoord;
+        }
+    )";
+    std::string vertexSource = quantized ? "#define QUANTIZED\n" : "";
+    if (maxJoints > 0) vertexSource += "#define SKINNED\n#define MAX_JOINTS " + std::to_string(maxJoints) + "\n";
+    vertexSource += vertexBody;
+    const char* vertexSrc = vertexSource.c_str();
+
+    // Fragment Shader z oświetleniem i teksturą
+    const char* fragmentSrc = R"(
+        precision mediump float;
+
+        varying vec3 v_normal;
+        varying vec2 v_texcoord;
+
+        uniform sampler2D u_texture;
+
+        void main() {
+            vec3 lightDir = normalize(vec3(0.5, 1.0, 0.3));
+            float light = max(dot(normalize(v_normal), lightDir), 0.0);
+            vec4 texColor = texture2D(u_texture, v_texcoord);
+            gl_FragColor = vec4(texColor.rgb * light, texColor.a);
+        }
+    )";
+
+    GLuint vs = CompileShader(GL_VERTEX_SHADER, vertexSrc);
+    if (vs == 0) return 0; // Dodano sprawdzenie kompilacji
+    GLuint fs = CompileShader(GL_FRAGMENT_SHADER, fragmentSrc);
+    if (fs == 0) return 0; // Dodano sprawdzenie kompilacji
+
+    GLuint program = glCreateProgram();
+    glAttachShader(program, vs);
+    glAttachShader(program, fs);
+    glBindAttribLocation(program, attrPositionLoc, "a_position");
+    glBindAttribLocation(program, attrNormalLoc, "a_normal");
+    glBindAttribLocation(program, attrTexcoordLoc, "a_texcoord");
+    glBindAttribLocation(program, attrInstanceLoc, "a_instance");
+    glBindAttribLocation(program, attrJointsLoc, "a_joints");
+    glBindAttribLocation(program, attrWeightsLoc, "a_weights");
+    glLinkProgram(program);
+
+    GLint linked;
+    glGetProgramiv(program, GL_LINK_STATUS, &linked);
+    if (!linked) {
+        char log[512];
+        glGetProgramInfoLog(program, 512, nullptr, log);
+        std::cerr << "Program link error: " << log << std::endl;
+        glDeleteProgram(program);
+        return 0;
+    }
+
+    glDeleteShader(vs);
+    glDeleteShader(fs);
+    return program;
+}
+
+// --- Format GL dla liczby kanałów obrazu ---
+inline GLenum ImageGLFormat(int component) {
+    if (component == 3) return GL_RGB;
+    if (component == 1) return GL_LUMINANCE;
+    return GL_RGBA;
+}
+
+// --- Upload zdekodowanego obrazu do tekstury GL ---
+inline GLuint UploadTexture(const tinygltf::Image& image) {
+    LOAD_PROFILE_SCOPE("UploadTexture (glTexImage2D)");
+    std::cout << "Ladowanie tekstury: " << image.name << " (" << image.width << "x" << image.height << ") format: " << image.pixel_type << "\n";
+
+    GLuint tex;
+    glGenTextures(1, &tex);
+    glState.BindTexture(GL_TEXTURE_2D, tex);
+
+    GLenum format = ImageGLFormat(image.component);
+
+    glTexImage2D(GL_TEXTURE_2D, 0, format,
+                 image.width, image.height, 0,
+                 format, GL_UNSIGNED_BYTE, image.image.data());
+
+    // Bez `glGenerateMipmap` (przestój przy ładowaniu) - mipmapy liczy w tle QueueMipmaps,
+    // a do czasu wgrania wszystkich poziomów próbkujemy z GL_LINEAR.
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+    std::cout << "Tekstura " << image.name << " zaladowana pomyslnie (ID: " << tex << ").\n";
+    return tex;
+}
+
+// --- Upload tekstury z pamięci podręcznej encode_textures (texture_compression.h); 0 = błąd GL ---
+inline GLuint UploadCachedTexture(const tinygltf::Image& image, CompressedFamily family, const CompressedTexture& compressed) {
+    SampleHeap();
+    GLuint tex = UploadCompressedTexture(compressed);
+    if (tex == 0) return 0;
+    const size_t bytes = CompressedTextureBytes(compressed);
+    textureGpuBytes += bytes;
+    std::cout << "Tekstura " << image.name << " (" << compressed.levels[0].width << "x" << compressed.levels[0].height
+              << ") skompresowana " << CompressedFamilyName(family) << ", poziomy: " << compressed.levels.size()
+              << ", " << bytes / 1024 << " KB (ID: " << tex << ").\n";
+    return tex;
+}
+
+// --- Tekstura z pliku pamięci podręcznej; 0 = brak ---
+// Pierwsza rodzina obsługiwana przez GPU, dla której istnieje plik z tym hashem obrazu.
+inline GLuint LoadCompressedTextureFromCache(const tinygltf::Image& image) {
+#ifdef __EMSCRIPTEN__
+    return 0; // Plików nie ma w MEMFS - pobiera je StartCompressedFetch
+#endif
+    if (!compressTextures || !image.as_is || image.image.empty()) return 0;
+    LOAD_PROFILE_SCOPE("LoadCompressedTextureFromCache");
+    const uint64_t hash = HashImageBytes(image.image.data(), image.image.size());
+    for (CompressedFamily family : {CompressedFamily::S3TC, CompressedFamily::ETC1}) {
+        if (!CompressedFamilySupported(family)) continue;
+        CompressedTexture compressed;
+        if (!ReadCompressedTexture(CompressedCachePath(hash, family), compressed)) continue;
+        GLuint tex = UploadCachedTexture(image, family, compressed);
+        if (tex != 0) return tex;
+    }
+    return 0;
+}
+
+#ifdef __EMSCRIPTEN__
+// --- Przeglądarka: .ctex pobierany na żądanie (emscripten_async_wget_data) ---
+// Tylko plik pierwszej rodziny obsługiwanej przez GPU. Bufor odpowiedzi emscripten zwalnia zaraz
+// po onload, czyli po uploadzie. Do tego czasu tekstury obrazu są białe; po błędzie (np. 404)
+// obraz wraca do LoadPendingTextures i jest dekodowany jak bez pamięci podręcznej.
+struct CompressedFetch {
+    const tinygltf::Model* model;
+    ModelGL* modelGL;
+    int image;
+    CompressedFamily family;
+    unsigned generation;
+};
+inline unsigned compressedFetchGeneration = 0; // ReleaseModelGL unieważnia pobierania w toku
+
+inline void FinishCompressedFetch(CompressedFetch* fetch, GLuint tex) {
+    if (fetch->generation == compressedFetchGeneration) {
+        ModelGL& modelGL = *fetch->modelGL;
+        --modelGL.compressedFetchesInFlight;
+        for (auto& entry : modelGL.textures) {
+            if (fetch->model->textures[entry.first].source == fetch->image) entry.second = tex;
+        }
+        // Następna klatka: dekodowanie obrazu po błędzie (tex == 0), po ostatnim pobraniu zwolnienie obrazów
+        modelGL.texturesPending = true;
+    }
+    delete fetch;
+}
+
+inline void OnCompressedFetchLoad(void* arg, void* data, int size) {
+    CompressedFetch* fetch = static_cast<CompressedFetch*>(arg);
+    GLuint tex = 0;
+    CompressedTexture compressed;
+    if (fetch->generation == compressedFetchGeneration &&
+        ParseCompressedTexture(static_cast<const unsigned char*>(data), (size_t)size, compressed)) {
+        tex = UploadCachedTexture(fetch->model->images[fetch->image], fetch->family, compressed);
+    }
+    FinishCompressedFetch(fetch, tex);
+}
+
+inline void OnCompressedFetchError(void* arg) {
+    CompressedFetch* fetch = static_cast<CompressedFetch*>(arg);
+    std::cerr << "Brak pliku .ctex dla obrazu " << fetch->image << " - dekodowanie PNG/JPEG.\n";
+    FinishCompressedFetch(fetch, 0);
+}
+
+// true = pobieranie ruszyło; obraz nie jest pobierany drugi raz (także po błędzie)
+inline bool StartCompressedFetch(const tinygltf::Model& model, ModelGL& modelGL, int image) {
+    const tinygltf::Image& source = model.images[image];
+    if (!compressTextures || !source.as_is || source.image.empty() || !modelGL.compressedFetches.insert(image).second) {
+        return false;
+    }
+    for (CompressedFamily family : {CompressedFamily::S3TC, CompressedFamily::ETC1}) {
+        if (!CompressedFamilySupported(family)) continue;
+        const std::string url = CompressedCachePath(HashImageBytes(source.image.data(), source.image.size()), family);
+        ++modelGL.compressedFetchesInFlight;
+        emscripten_async_wget_data(url.c_str(), new CompressedFetch{&model, &modelGL, image, family, compressedFetchGeneration},
+                                   OnCompressedFetchLoad, OnCompressedFetchError);
+        return true;
+    }
+    return false;
+}
+#endif
+
+// Czasy wczytywania tekstur (bench_render); z nimi każdy upload kończy glFinish, żeby praca
+// sterownika nie przeszła do pierwszej klatki
+struct TextureLoadTimings {
+    double decodeMs = 0;
+    double uploadMs = 0;
+};
+
+// --- Ładowanie tekstury z GLTF ---
+inline GLuint LoadTextureFromGLTF(const tinygltf::Model& model, int textureIndex, TextureLoadTimings* timings = nullptr) {
+    if (textureIndex == -1 || textureIndex >= (int)model.textures.size()) {
+        std::cerr << "Niepoprawny indeks tekstury (" << textureIndex << "). Brak tekstury lub poza zakresem.\n";
+        return 0;
+    }
+
+    const auto& texture = model.textures[textureIndex];
+    if (texture.source < 0 || texture.source >= (int)model.images.size()) {
+        // KHR_texture_basisu bez obrazu zastępczego: KTX2/Basis wymaga transkodera, którego nie mamy
+        if (texture.extensions.count("KHR_texture_basisu")) {
+            std::cerr << "Tekstura " << textureIndex << " ma tylko zrodlo KHR_texture_basisu (brak transkodera Basis).\n";
+        }
+        std::cerr << "Niepoprawny indeks zrodla obrazu dla tekstury " << textureIndex << ".\n";
+        return 0;
+    }
+    using Clock = std::chrono::steady_clock;
+    auto elapsedMs = [](Clock::time_point start) { return std::chrono::duration<double, std::milli>(Clock::now() - start).count(); };
+    auto uploadDone = [&](Clock::time_point start) {
+        if (!timings) return;
+        glFinish();
+        timings->uploadMs += elapsedMs(start);
+    };
+
+    Clock::time_point start = Clock::now();
+    GLuint compressed = LoadCompressedTextureFromCache(model.images[texture.source]);
+    if (compressed != 0) {
+        uploadDone(start);
+        return compressed;
+    }
+
+    // Obraz wczytany z SetImagesAsIs(true) trzyma skompresowany PNG/JPEG - dekodujemy go
+    // do tymczasowego obiektu, który zwalnia piksele zaraz po glTexImage2D
+    tinygltf::Image decoded;
+    std::string decodeErr, decodeWarn;
+    bool ok;
+    start = Clock::now();
+    {
+        LOAD_PROFILE_SCOPE("DecodeImageAsIs (PNG/JPEG)");
+        ok = tinygltf::DecodeImageAsIs(model.images[texture.source], &decoded, texture.source, &decodeErr, &decodeWarn);
+    }
+    if (timings) timings->decodeMs += elapsedMs(start);
+    if (!ok) {
+        std::cerr << "Nie udalo sie zdekodowac obrazu dla tekstury " << textureIndex << ": " << decodeErr << "\n";
+        return 0;
+    }
+    SampleHeap(); // Zdekodowane piksele to zwykle szczyt pamięci
+    start = Clock::now();
+    GLuint tex = UploadTexture(decoded);
+    uploadDone(start);
+    size_t bytes = decoded.image.size();
+    if (decoded.bits == 8) {
+        // Piksele przechodzą do wątku liczącego mipmapy (bez kopii)
+        if (QueueMipmaps(tex, ImageGLFormat(decoded.component), decoded.component, decoded.width, decoded.height,
+                         std::move(decoded.image))) {
+            bytes += bytes / 3;
+        }
+    }
+    textureGpuBytes += bytes;
+    return tex;
+}
+
+// --- Domyślna biała tekstura 1x1, gdy model nie ma własnej ---
+inline GLuint CreateWhiteTexture() {
+    GLuint tex;
+    glGenTextures(1, &tex);
+    glState.BindTexture(GL_TEXTURE_2D, tex);
+    unsigned char whitePixel[] = {255, 255, 255, 255}; // Biały piksel
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, whitePixel);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    std::cout << "Domyślna biała tekstura utworzona (ID: " << tex << ").\n";
+    return tex;
+}
+
+// --- Zwolnienie danych binarnych modelu (geometria jest już w VBO/EBO) ---
+// Bufory zmapowane z pliku są odmapowywane, gdy znika ostatnie odwołanie do mapowania.
+inline void ReleaseModelBuffers(tinygltf::Model& model) {
+    for (auto& buffer : model.buffers) {
+        std::vector<unsigned char>().swap(buffer.data);
+        buffer.mapping.reset();
+        buffer.mapped_data = nullptr;
+        buffer.mapped_size = 0;
+    }
+}
+
+// --- Zwolnienie (skompresowanych) obrazów modelu - po uploadzie tekstur ---
+inline void ReleaseModelImages(tinygltf::Model& model) {
+    for (auto& image : model.images) std::vector<unsigned char>().swap(image.image);
+}
+
+// --- Bajty danych CPU trzymanych przez model (bufory, także zmapowane, i obrazy) ---
+inline size_t ModelCPUBytes(const tinygltf::Model& model) {
+    size_t bytes = 0;
+    for (const auto& buffer : model.buffers) bytes += buffer.DataSize();
+    for (const auto& image : model.images) bytes += image.image.size();
+    return bytes;
+}
+
+// --- Wczytywanie pliku GLB do gltfModel ---
+inline bool LoadGLB(const std::string& path) {
+    gltfModel = tinygltf::Model();
+    ResetHeapPeak();
+    loadProfiler.Reset(); // Nowa sesja profilu: od pliku do ostatniej mipmapy
+    LOAD_PROFILE_SCOPE("LoadGLB");
+
+    tinygltf::TinyGLTF loader;
+    loader.SetMemoryMapBinary(true); // Bufory GLB czytane bezpośrednio z mapowania pliku, bez kopii
+    loader.SetImageDecodeThreads(0); // Dekodowanie obrazów na wszystkich rdzeniach (w wasm bez pthreads - szeregowo)
+    loader.SetImagesAsIs(true); // Obrazy zostają skompresowane, dekodujemy tylko te faktycznie użyte
+    std::string err, warn;
+    if (!loader.LoadBinaryFromFile(&gltfModel, &err, &warn, path)) {
+        std::cerr << "Failed to load model: " << err << std::endl;
+        return false;
+    }
+    if (!warn.empty()) std::cout << "GLTF Warning: " << warn << std::endl;
+
+    std::cout << "Liczba scen: " << gltfModel.scenes.size() << std::endl;
+    std::cout << "Liczba meshy: " << gltfModel.meshes.size() << std::endl;
+    std::cout << "Liczba buforow: " << gltfModel.buffers.size() << std::endl;
+    SampleHeap();
+    return true;
+}
+
+// --- Shader i lokalizacje atrybutów/uniformów (wymaga aktywnego kontekstu GL) ---
+inline bool InitRenderer(GLProcLoader getProcAddress) {
+    glEnable(GL_DEPTH_TEST);
+
+    LoadGLExtensions(getProcAddress);
+    glState.Invalidate(); // Nowy kontekst - nic nie wiemy o zbindowanych obiektach
+    frameStats.ResetGpu();
+
+    // Paleta stawów: 3 vec4 na staw; reszta uniformów vertex shadera zajmuje poniżej kReservedVectors.
+    // Minimum GLES2 (128 wektorów) daje 37 stawów, górny limit trzyma krótki czas kompilacji i uploadu.
+    const int kReservedVectors = 16, kMaxPaletteJoints = 64;
+    GLint maxVectors = 128;
+    glGetIntegerv(GL_MAX_VERTEX_UNIFORM_VECTORS, &maxVectors);
+    gpuSkinJoints = std::min(kMaxPaletteJoints, (maxVectors - kReservedVectors) / 3);
+    if (skinningJointLimit > 0) gpuSkinJoints = std::min(gpuSkinJoints, skinningJointLimit);
+    uploadedPaletteSkin = -1;
+
+    for (ShaderGL* target : {&floatShader, &quantizedShader, &skinnedShader}) {
+        const bool quantized = target == &quantizedShader;
+        ShaderGL& shader = *target;
+        shader = ShaderGL();
+        shader.program = CreateShaderProgram(quantized, target == &skinnedShader ? gpuSkinJoints : 0);
+        if (!shader.program) return false;
+
+        shader.uniformMVPLoc = glGetUniformLocation(shader.program, "u_mvp");
+        shader.uniformNormalMatrixLoc = glGetUniformLocation(shader.program, "u_normalMatrix");
+        shader.uniformTextureLoc = glGetUniformLocation(shader.program, "u_texture");
+        shader.uniformPositionScaleLoc = glGetUniformLocation(shader.program, "u_positionScale");
+        shader.uniformPositionOffsetLoc = glGetUniformLocation(shader.program, "u_positionOffset");
+        shader.uniformTexcoordTransformLoc = glGetUniformLocation(shader.program, "u_texcoordTransform");
+        shader.uniformJointsLoc = glGetUniformLocation(shader.program, "u_joints");
+    }
+    instanceAttribDirty = true;
+
+    std::cout << "uniformMVP location: " << floatShader.uniformMVPLoc << std::endl;
+    std::cout << "uniformNormalMatrix location: " << floatShader.uniformNormalMatrixLoc << std::endl;
+    std::cout << "Skinning GPU: do " << gpuSkinJoints << " stawow (" << maxVectors << " wektorow uniform)" << std::endl;
+    return true;
+}
+
+// --- Układ atrybutów Vertex / QuantizedVertex dla aktualnie zbindowanego VBO ---
+// Zapisywany raz w VAO meshu albo (bez rozszerzenia) wywoływany przed każdym rysowaniem
+inline void SetupVertexAttributes(bool quantized) {
+    if (quantized) {
+        const GLsizei stride = sizeof(QuantizedVertex);
+        glEnableVertexAttribArray(attrPositionLoc);
+        glVertexAttribPointer(attrPositionLoc, 3, GL_SHORT, GL_TRUE, stride, (void*)offsetof(QuantizedVertex, position));
+        glEnableVertexAttribArray(attrNormalLoc);
+        glVertexAttribPointer(attrNormalLoc, 2, GL_SHORT, GL_TRUE, stride, (void*)offsetof(QuantizedVertex, normal));
+        glEnableVertexAttribArray(attrTexcoordLoc);
+        glVertexAttribPointer(attrTexcoordLoc, 2, GL_UNSIGNED_SHORT, GL_TRUE, stride, (void*)offsetof(QuantizedVertex, texcoord));
+        return;
+    }
+
+    glEnableVertexAttribArray(attrPositionLoc);
+    glVertexAttribPointer(attrPositionLoc, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, position));
+
+    glEnableVertexAttribArray(attrNormalLoc);
+    glVertexAttribPointer(attrNormalLoc, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, normal));
+
+    glEnableVertexAttribArray(attrTexcoordLoc);
+    glVertexAttribPointer(attrTexcoordLoc, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, texcoord));
+}
+
+// --- Wskaźniki atrybutów meshu ładowanego bezpośrednio z bufferView ---
+// Brakujący atrybut ma wyłączoną tablicę - shader dostaje stałą (0, 0, 0, 1)
+inline void SetupDirectAttributes(const MeshGL& mesh) {
+    const GLint locations[3] = {attrPositionLoc, attrNormalLoc, attrTexcoordLoc};
+    for (int i = 0; i < 3; ++i) {
+        const VertexAttribGL& attrib = mesh.attribs[i];
+        if (attrib.buffer == 0) {
+            glDisableVertexAttribArray(locations[i]);
+            continue;
+        }
+        glState.BindBuffer(GL_ARRAY_BUFFER, attrib.buffer);
+        glEnableVertexAttribArray(locations[i]);
+        glVertexAttribPointer(locations[i], attrib.size, attrib.type, attrib.normalized, attrib.stride, (void*)attrib.offset);
+    }
+}
+
+// --- Macierz per instancja z aktualnie zbindowanego VBO instancji (divisor 1) ---
+inline void SetupInstanceAttributes() {
+    for (int column = 0; column < 4; ++column) {
+        GLuint loc = attrInstanceLoc + column;
+        glEnableVertexAttribArray(loc);
+        glVertexAttribPointer(loc, 4, GL_FLOAT, GL_FALSE, sizeof(glm::mat4), (void*)(sizeof(glm::vec4) * column));
+        glExt.vertexAttribDivisor(loc, 1);
+    }
+}
+
+inline void DisableInstanceAttributes() {
+    for (int column = 0; column < 4; ++column) {
+        glExt.vertexAttribDivisor(attrInstanceLoc + column, 0);
+        glDisableVertexAttribArray(attrInstanceLoc + column);
+    }
+}
+
+// --- Indeksy stawów i wagi z aktualnie zbindowanego VBO SkinVertex ---
+inline void SetupSkinAttributes() {
+    glEnableVertexAttribArray(attrJointsLoc);
+    glVertexAttribPointer(attrJointsLoc, 4, GL_UNSIGNED_SHORT, GL_FALSE, sizeof(SkinVertex), (void*)offsetof(SkinVertex, joints));
+    glEnableVertexAttribArray(attrWeightsLoc);
+    glVertexAttribPointer(attrWeightsLoc, 4, GL_FLOAT, GL_FALSE, sizeof(SkinVertex), (void*)offsetof(SkinVertex, weights));
+}
+
+inline void DisableSkinAttributes() {
+    glDisableVertexAttribArray(attrJointsLoc);
+    glDisableVertexAttribArray(attrWeightsLoc);
+}
+
+// --- Stała (bez tablicy) wartość a_instance dla zwykłych draw calli ---
+inline void SetInstanceAttributeIdentity() {
+    const glm::mat4 identity(1.0f);
+    for (int column = 0; column < 4; ++column) {
+        glVertexAttrib4fv(attrInstanceLoc + column, glm::value_ptr(identity[column]));
+    }
+    instanceAttribDirty = false;
+}
+
+// --- Czy górne 3x3 to obrót (lub odbicie) ze skalą jednorodną, tzn. mat3(m) przenosi normalne poprawnie ---
+// Shader instancji liczy normalne przez mat3(a_instance) zamiast odwrotności transpozycji; przy
+// kolumnach ortogonalnych o równej długości obie dają ten sam kierunek (różnią się tylko skalą).
+inline bool HasUniformScale(const glm::mat4& m, float tolerance = 1e-3f) {
+    const glm::vec3 x(m[0]), y(m[1]), z(m[2]);
+    const float xx = glm::dot(x, x), yy = glm::dot(y, y), zz = glm::dot(z, z);
+    const float limit = tolerance * std::max(xx, std::max(yy, zz));
+    return std::abs(xx - yy) <= limit && std::abs(xx - zz) <= limit && std::abs(glm::dot(x, y)) <= limit &&
+           std::abs(glm::dot(x, z)) <= limit && std::abs(glm::dot(y, z)) <= limit;
+}
+
+// --- Macierze instancji meshu; z instancingiem sprzętowym także VBO zapisany w VAO ---
+inline void AttachInstances(MeshGL& mesh, const std::vector<glm::mat4>& instances) {
+    mesh.instances = instances;
+    if (!glExt.instancedArrays) return; // Fallback: RenderFrame rysuje każdą instancję osobno z własnym u_mvp
+
+    glGenBuffers(1, &mesh.instanceVbo);
+    glState.BindBuffer(GL_ARRAY_BUFFER, mesh.instanceVbo);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(glm::mat4) * instances.size(), instances.data(), GL_STATIC_DRAW);
+
+    if (mesh.vao != 0) {
+        glState.BindVertexArray(mesh.vao);
+        SetupInstanceAttributes();
+        glState.BindVertexArray(0);
+    }
+}
+
+// --- Liczba glDrawElements* na klatkę dla modelu ---
+inline size_t CountDrawCalls(const ModelGL& modelGL) {
+    size_t draws = 0;
+    for (const auto& mesh : modelGL.meshes) {
+        draws += (mesh.instances.empty() || mesh.instanceVbo != 0) ? 1 : mesh.instances.size();
+    }
+    return draws;
+}
+
+// --- VBO, EBO i (jeśli dostępne) VAO dla gotowych wierzchołków i indeksów ---
+inline MeshGL UploadMeshGL(const Vertex* vertices, size_t vertexCount, const void* indices, GLsizei indexCount,
+                           GLenum indexType, bool quantize = quantizeVertices, GLenum usage = GL_STATIC_DRAW) {
+    MeshGL mesh;
+    mesh.indexCount = indexCount;
+    mesh.indexType = indexType;
+    VertexBounds(reinterpret_cast<const float*>(vertices), vertexCount, sizeof(Vertex) / sizeof(float), mesh.boundsMin,
+                 mesh.boundsMax);
+    mesh.hasBounds = vertexCount > 0;
+
+    size_t indexSize = (indexType == GL_UNSIGNED_INT) ? 4 : (indexType == GL_UNSIGNED_SHORT) ? 2 : 1;
+
+    glGenBuffers(1, &mesh.vbo);
+    glState.BindBuffer(GL_ARRAY_BUFFER, mesh.vbo);
+    if (quantize) {
+        std::vector<QuantizedVertex> quantized = QuantizeVertices(vertices, vertexCount, mesh.quantization, quantizationReport);
+        glBufferData(GL_ARRAY_BUFFER, sizeof(QuantizedVertex) * quantized.size(), quantized.data(), GL_STATIC_DRAW);
+        mesh.quantized = true;
+    } else {
+        glBufferData(GL_ARRAY_BUFFER, sizeof(Vertex) * vertexCount, vertices, usage);
+    }
+
+    glGenBuffers(1, &mesh.ebo);
+    glState.BindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.ebo);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indexSize * indexCount, indices, GL_STATIC_DRAW);
+
+    // VAO zapamiętuje EBO i wskaźniki atrybutów - rysowanie to potem jeden bind
+    if (glExt.vertexArrayObject) {
+        glExt.genVertexArrays(1, &mesh.vao);
+        glState.BindVertexArray(mesh.vao);
+        glState.BindBuffer(GL_ARRAY_BUFFER, mesh.vbo);
+        glState.BindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.ebo);
+        SetupVertexAttributes(mesh.quantized);
+        glState.BindVertexArray(0);
+    }
+    return mesh;
+}
+
+// --- Prymityw z więcej niż 65536 wierzchołkami bez OES_element_index_uint ---
+// Trójkąty są rozdzielane zachłannie na części, z których każda ma własny VBO
+// z co najwyżej 65536 wierzchołkami i indeksy 16-bit.
+inline void UploadSplitMeshGL(const std::vector<Vertex>& vertices, const uint32_t* indices,
+                              size_t indexCount, std::vector<MeshGL>& out) {
+    const size_t kMaxChunkVertices = 65536;
+
+    std::vector<int32_t> remap(vertices.size(), -1); // Indeks źródłowy -> indeks w bieżącej części
+    std::vector<uint32_t> used;
+    std::vector<Vertex> chunkVertices;
+    std::vector<uint16_t> chunkIndices;
+
+    auto flush = [&]() {
+        if (!chunkIndices.empty()) {
+            out.push_back(UploadMeshGL(chunkVertices.data(), chunkVertices.size(),
+                                       chunkIndices.data(), (GLsizei)chunkIndices.size(), GL_UNSIGNED_SHORT));
+        }
+        for (uint32_t v : used) remap[v] = -1;
+        used.clear();
+        chunkVertices.clear();
+        chunkIndices.clear();
+    };
+
+    for (size_t t = 0; t + 2 < indexCount; t += 3) {
+        if (indices[t] >= vertices.size() || indices[t + 1] >= vertices.size() || indices[t + 2] >= vertices.size()) {
+            continue; // Uszkodzony trójkąt - indeks poza zakresem
+        }
+        if (chunkVertices.size() + 3 > kMaxChunkVertices) flush();
+
+        for (int k = 0; k < 3; ++k) {
+            uint32_t v = indices[t + k];
+            if (remap[v] < 0) {
+                remap[v] = (int32_t)chunkVertices.size();
+                chunkVertices.push_back(vertices[v]);
+                used.push_back(v);
+            }
+            chunkIndices.push_back((uint16_t)remap[v]);
+        }
+    }
+    flush();
+}
+
+// --- Prymityw prosto z bufferView, bez przepakowania do Vertex ---
+// Każdy bufferView trafia do GL raz (ModelGL::arrayViewBuffers / elementViewBuffers)
+// i jest współdzielony przez wszystkie prymitywy, które go używają. Zwraca false,
+// gdy układ nie nadaje się do bezpośredniego użycia - wtedy zostaje ścieżka z Vertex.
+inline bool UploadDirectMeshGL(const tinygltf::Model& model, const tinygltf::Primitive& primitive,
+                               ModelGL& modelGL, MeshGL& out) {
+    if (quantizeVertices || primitive.indices < 0) return false;
+    LOAD_PROFILE_SCOPE("UploadDirectMeshGL (bufferView)");
+    if (primitive.mode != -1 && primitive.mode != TINYGLTF_MODE_TRIANGLES) return false;
+
+    struct Source { int accessor; int components; };
+    const char* names[3] = {"POSITION", "NORMAL", "TEXCOORD_0"};
+    const int components[3] = {3, 3, 2};
+    Source sources[3];
+    for (int i = 0; i < 3; ++i) {
+        auto it = primitive.attributes.find(names[i]);
+        sources[i] = {(it != primitive.attributes.end()) ? it->second : -1, components[i]};
+    }
+    if (sources[0].accessor < 0) return false;
+
+    // Offset i stride muszą być wielokrotnością rozmiaru składowej (WebGL), bufferView nie może być EBO
+    auto compatible = [&](const tinygltf::Accessor& accessor, const AccessorData& view) {
+        const int componentSize = tinygltf::GetComponentSizeInBytes(static_cast<uint32_t>(accessor.componentType));
+        return componentSize > 0 && accessor.byteOffset % componentSize == 0 &&
+               model.bufferViews[accessor.bufferView].byteOffset % componentSize == 0 && view.stride % componentSize == 0;
+    };
+
+    VertexAttribGL attribs[3];
+    int attribViews[3] = {-1, -1, -1};
+    for (int i = 0; i < 3; ++i) {
+        if (sources[i].accessor < 0) continue;
+        const auto& accessor = model.accessors[sources[i].accessor];
+        AccessorData view;
+        if (!GetAccessorData(model, accessor, view) || view.components != sources[i].components) return false;
+        if (!AccessorGLFormat(view, attribs[i].type, attribs[i].normalized) || !compatible(accessor, view)) return false;
+        if (modelGL.elementViewBuffers.count(accessor.bufferView)) return false;
+        attribs[i].size = view.components;
+        attribs[i].stride = (GLsizei)view.stride;
+        attribs[i].offset = accessor.byteOffset;
+        attribViews[i] = accessor.bufferView;
+    }
+
+    const auto& indexAccessor = model.accessors[primitive.indices];
+    AccessorData indexView;
+    if (!GetAccessorData(model, indexAccessor, indexView) || !indexView.data || indexView.sparse) return false;
+    GLenum indexType;
+    switch (indexAccessor.componentType) {
+    case TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE: indexType = GL_UNSIGNED_BYTE; break;
+    case TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT: indexType = GL_UNSIGNED_SHORT; break;
+    case TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT:
+        if (!glExt.elementIndexUint) return false;
+        indexType = GL_UNSIGNED_INT;
+        break;
+    default: return false;
+    }
+    // Indeksy muszą być ciasno upakowane i nie mogą dzielić bufferView z atrybutami
+    const int indexSize = tinygltf::GetComponentSizeInBytes(static_cast<uint32_t>(indexAccessor.componentType));
+    if ((int)indexView.stride != indexSize || !compatible(indexAccessor, indexView)) return false;
+    if (modelGL.arrayViewBuffers.count(indexAccessor.bufferView)) return false;
+    for (int view : attribViews) {
+        if (view == indexAccessor.bufferView) return false;
+    }
+
+    auto viewBuffer = [&](std::map<int, GLuint>& buffers, int viewIndex, GLenum target) {
+        auto it = buffers.find(viewIndex);
+        if (it != buffers.end()) return it->second;
+        const auto& view = model.bufferViews[viewIndex];
+        GLuint buffer;
+        glGenBuffers(1, &buffer);
+        glState.BindBuffer(target, buffer);
+        glBufferData(target, view.byteLength, model.buffers[view.buffer].DataPtr() + view.byteOffset, GL_STATIC_DRAW);
+        buffers[viewIndex] = buffer;
+        return buffer;
+    };
+
+    out = MeshGL();
+    out.direct = true;
+    for (int i = 0; i < 3; ++i) {
+        if (attribViews[i] < 0) continue;
+        out.attribs[i] = attribs[i];
+        out.attribs[i].buffer = viewBuffer(modelGL.arrayViewBuffers, attribViews[i], GL_ARRAY_BUFFER);
+    }
+    out.ebo = viewBuffer(modelGL.elementViewBuffers, indexAccessor.bufferView, GL_ELEMENT_ARRAY_BUFFER);
+    out.indexCount = (GLsizei)indexAccessor.count;
+    out.indexType = indexType;
+    out.indexOffset = indexAccessor.byteOffset;
+    out.material = primitive.material;
+    out.hasBounds = AccessorBounds(model.accessors[sources[0].accessor], out.boundsMin, out.boundsMax);
+
+    if (glExt.vertexArrayObject) {
+        glExt.genVertexArrays(1, &out.vao);
+        glState.BindVertexArray(out.vao);
+        glState.BindBuffer(GL_ELEMENT_ARRAY_BUFFER, out.ebo);
+        SetupDirectAttributes(out);
+        glState.BindVertexArray(0);
+    }
+    return true;
+}
+
+// --- Dopisanie wierzchołków i indeksów prymitywu (po transformacji) do wspólnych tablic ---
+inline bool AppendPrimitive(const tinygltf::Model& model, const tinygltf::Primitive& primitive, const glm::mat4& transform,
+                            std::vector<Vertex>& vertices, std::vector<uint32_t>& indices) {
+    LOAD_PROFILE_SCOPE("AppendPrimitive (pakowanie wierzcholkow)");
+    auto findAccessorIndex = [&](const std::string& name) -> int {
+        auto it = primitive.attributes.find(name);
+        return (it != primitive.attributes.end()) ? it->second : -1;
+    };
+
+    int posIndex = findAccessorIndex("POSITION");
+    int normIndex = findAccessorIndex("NORMAL");
+    int texIndex = findAccessorIndex("TEXCOORD_0");
+
+    if (posIndex == -1 || primitive.indices == -1) {
+        std::cerr << "Pominieto prymityw - brakuje atrybutow POSITION lub indeksow!\n";
+        return false;
+    }
+
+    const auto& indexAccessor = model.accessors[primitive.indices];
+    if (indexAccessor.componentType != TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE &&
+        indexAccessor.componentType != TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT &&
+        indexAccessor.componentType != TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT) {
+        std::cerr << "Pominieto prymityw - nieobslugiwany typ indeksow: " << indexAccessor.componentType << "\n";
+        return false;
+    }
+
+    // Atrybut float czytany wprost z bufora (krok z Accessor::ByteStride); inne typy
+    // składowych, normalized i sparse są najpierw konwertowane przez ReadAccessor
+    std::vector<float> converted[3];
+    auto attributeStream = [&](int accessorIndex, int components, std::vector<float>& storage) -> AttributeStream {
+        AttributeStream stream;
+        if (accessorIndex == -1) return stream;
+        const auto& accessor = model.accessors[accessorIndex];
+        AccessorData view;
+        if (!GetAccessorData(model, accessor, view)) return stream;
+        if (IsDirectFloatAccessor(view, components)) {
+            stream.data = view.data;
+            stream.stride = view.stride;
+        } else if (ReadAccessor(model, accessor, storage, components)) {
+            stream.data = reinterpret_cast<const unsigned char*>(storage.data());
+            stream.stride = components * sizeof(float);
+        }
+        return stream;
+    };
+
+    const AttributeStream positions = attributeStream(posIndex, 3, converted[0]);
+    if (!positions.data) {
+        std::cerr << "Pominieto prymityw - nie mozna odczytac POSITION\n";
+        return false;
+    }
+    // Normalne i texcoordy mogą nie istnieć - wtedy wypełniane zerami
+    const AttributeStream normals = attributeStream(normIndex, 3, converted[1]);
+    const AttributeStream texcoords = attributeStream(texIndex, 2, converted[2]);
+
+    // Normalne transformujemy macierzą odwrotną-transponowaną (skalowanie niejednorodne)
+    const bool identity = (transform == glm::mat4(1.0f));
+    const glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3(transform)));
+    GatherTransform gatherTransform;
+    if (!identity) {
+        gatherTransform.matrix = glm::value_ptr(transform);
+        gatherTransform.normalMatrix = glm::value_ptr(normalMatrix);
+    }
+
+    const size_t base = vertices.size();
+    const size_t vertexCount = model.accessors[posIndex].count;
+    vertices.resize(base + vertexCount);
+    GatherVertices(reinterpret_cast<float*>(vertices.data() + base), vertexCount, positions, normals, texcoords, gatherTransform);
+
+    // Indeksy zawsze poszerzane do 32 bitów - typ na GPU wybiera EmitMeshGL po scaleniu
+    std::vector<uint32_t> primitiveIndices;
+    if (!ReadAccessor(model, indexAccessor, primitiveIndices, 1)) {
+        vertices.resize(base);
+        return false;
+    }
+    indices.reserve(indices.size() + primitiveIndices.size());
+    for (uint32_t index : primitiveIndices) indices.push_back((uint32_t)base + index);
+    return true;
+}
+
+// --- Upload scalonej geometrii z najmniejszym typem indeksów, jaki obsłuży GPU ---
+inline void EmitMeshGL(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices,
+                       int material, int node, const glm::mat4& transform, std::vector<MeshGL>& out) {
+    if (indices.empty()) return;
+    LOAD_PROFILE_SCOPE("EmitMeshGL (upload VBO/EBO)");
+
+    const size_t first = out.size();
+    const uint32_t maxIndex = *std::max_element(indices.begin(), indices.end());
+    const GLsizei indexCount = (GLsizei)indices.size();
+
+    if (maxIndex <= 0xFFFF) {
+        // 16 bitów działa wszędzie i zajmuje połowę
+        std::vector<uint16_t> indices16(indices.begin(), indices.end());
+        out.push_back(UploadMeshGL(vertices.data(), vertices.size(), indices16.data(), indexCount, GL_UNSIGNED_SHORT));
+    } else if (glExt.elementIndexUint) {
+        out.push_back(UploadMeshGL(vertices.data(), vertices.size(), indices.data(), indexCount, GL_UNSIGNED_INT));
+    } else {
+        UploadSplitMeshGL(vertices, indices.data(), indices.size(), out);
+        std::cout << "Geometria z " << vertices.size() << " wierzcholkami podzielona na "
+                  << out.size() - first << " czesci z indeksami 16-bit\n";
+    }
+
+    for (size_t i = first; i < out.size(); ++i) {
+        out[i].material = material;
+        out[i].node = node;
+        out[i].transform = transform;
+    }
+}
+
+// --- VBO/EBO meshu przeliczanego na CPU (skinning, morph targety) ---
+// Bez kwantyzacji i bez podziału na części 16-bit - wierzchołki odpowiadają 1:1 danym źródłowym.
+inline bool UploadUnsplitMeshGL(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices, GLenum usage,
+                                MeshGL& mesh) {
+    const uint32_t maxIndex = *std::max_element(indices.begin(), indices.end());
+    if (maxIndex <= 0xFFFF) {
+        std::vector<uint16_t> indices16(indices.begin(), indices.end());
+        mesh = UploadMeshGL(vertices.data(), vertices.size(), indices16.data(), (GLsizei)indices.size(), GL_UNSIGNED_SHORT,
+                            false, usage);
+    } else if (glExt.elementIndexUint) {
+        mesh = UploadMeshGL(vertices.data(), vertices.size(), indices.data(), (GLsizei)indices.size(), GL_UNSIGNED_INT, false,
+                            usage);
+    } else {
+        std::cerr << "Mesh animowany na CPU z " << vertices.size() << " wierzcholkami wymaga OES_element_index_uint\n";
+        return false;
+    }
+    return true;
+}
+
+// --- Wagi morph targetów przed animacją: node.weights, a bez nich mesh.weights ---
+inline std::vector<float> DefaultMorphWeights(const tinygltf::Model& model, int node, int meshIndex) {
+    const std::vector<double>* weights = &model.meshes[meshIndex].weights;
+    if (node >= 0 && !model.nodes[node].weights.empty()) weights = &model.nodes[node].weights;
+    return std::vector<float>(weights->begin(), weights->end());
+}
+
+// --- Rzadkie delty prymitywu i wierzchołki dla domyślnych wag (nadpisuje vertices) ---
+inline bool PrepareMorphMesh(const tinygltf::Model& model, const tinygltf::Primitive& primitive, int node,
+                             const std::vector<float>& weights, std::vector<Vertex>& vertices, MorphMeshGL& out) {
+    if (primitive.targets.empty()) return false;
+    LOAD_PROFILE_SCOPE("ReadMorphTargets");
+    out = MorphMeshGL();
+    if (!ReadMorphTargets(model, primitive, vertices.size(), out.morph.targets)) return false;
+    out.node = node;
+    const float* first = reinterpret_cast<const float*>(vertices.data());
+    out.morph.base.assign(first, first + vertices.size() * 8);
+    uint32_t begin, end;
+    EvaluateMorph(out.morph, weights.data(), weights.size(), begin, end);
+    std::memcpy(reinterpret_cast<float*>(vertices.data()), out.morph.current.data(), out.morph.current.size() * sizeof(float));
+    return true;
+}
+
+// --- Prymityw z morph targetami (bez skina): własny dynamiczny VBO z macierzą świata węzła ---
+inline bool UploadMorphMeshGL(const tinygltf::Model& model, const tinygltf::Primitive& primitive, int node,
+                              const glm::mat4& world, const std::vector<float>& weights, ModelGL& modelGL) {
+    std::vector<Vertex> vertices;
+    std::vector<uint32_t> indices;
+    if (!AppendPrimitive(model, primitive, glm::mat4(1.0f), vertices, indices) || indices.empty()) return false;
+    MorphMeshGL morph;
+    MeshGL mesh;
+    if (!PrepareMorphMesh(model, primitive, node, weights, vertices, morph)) return false;
+    if (!UploadUnsplitMeshGL(vertices, indices, GL_DYNAMIC_DRAW, mesh)) return false;
+    mesh.material = primitive.material;
+    mesh.node = node;
+    mesh.transform = world;
+    mesh.hasBounds = false; // Wierzchołki zależą od wag
+    morph.vbo = mesh.vbo;
+    modelGL.morphs.push_back(std::move(morph));
+    modelGL.meshes.push_back(mesh);
+    return true;
+}
+
+// --- Prymityw skinowany: własny VBO z Vertex w pozie wiązania i strumień SkinVertex ---
+// Skin mieszczący się w palecie GPU dostaje skinVbo (wariant SKINNED), większy - skinning
+// na CPU do dynamicznego VBO. Morph targety są liczone przed skinningiem (na pozie wiązania).
+inline bool UploadSkinnedMeshGL(const tinygltf::Model& model, const tinygltf::Primitive& primitive, int skin, int node,
+                                const std::vector<float>& weights, ModelGL& modelGL) {
+    if (skin < 0 || skin >= (int)modelGL.skins.size() || modelGL.skins[skin].joints.empty()) return false;
+    LOAD_PROFILE_SCOPE("UploadSkinnedMeshGL");
+    std::vector<SkinVertex> skinVertices;
+    if (!ReadSkinVertices(model, primitive, modelGL.skins[skin].JointCount(), skinVertices)) return false;
+    std::vector<Vertex> vertices;
+    std::vector<uint32_t> indices;
+    if (!AppendPrimitive(model, primitive, glm::mat4(1.0f), vertices, indices) || indices.empty()) return false;
+    if (skinVertices.size() != vertices.size()) return false;
+
+    MorphMeshGL morph;
+    const bool morphed = PrepareMorphMesh(model, primitive, node, weights, vertices, morph);
+    const bool gpu = (int)modelGL.skins[skin].JointCount() <= gpuSkinJoints;
+    MeshGL mesh;
+    if (!UploadUnsplitMeshGL(vertices, indices, (gpu && !morphed) ? GL_STATIC_DRAW : GL_DYNAMIC_DRAW, mesh)) return false;
+    mesh.material = primitive.material;
+    mesh.skin = skin;
+    mesh.hasBounds = false; // Pozycje daje paleta stawów
+
+    if (gpu) {
+        glGenBuffers(1, &mesh.skinVbo);
+        glState.BindBuffer(GL_ARRAY_BUFFER, mesh.skinVbo);
+        glBufferData(GL_ARRAY_BUFFER, sizeof(SkinVertex) * skinVertices.size(), skinVertices.data(), GL_STATIC_DRAW);
+        if (mesh.vao != 0) {
+            glState.BindVertexArray(mesh.vao);
+            SetupSkinAttributes();
+            glState.BindVertexArray(0);
+        }
+    } else {
+        CpuSkinnedMesh cpu;
+        cpu.skin = skin;
+        cpu.vbo = mesh.vbo;
+        cpu.skinned.resize(vertices.size());
+        cpu.bindVertices = std::move(vertices);
+        cpu.skinVertices = std::move(skinVertices);
+        mesh.cpuSkin = (int)modelGL.cpuSkins.size();
+        modelGL.cpuSkins.push_back(std::move(cpu));
+    }
+    if (morphed) {
+        morph.vbo = mesh.vbo;
+        morph.cpuSkin = mesh.cpuSkin;
+        modelGL.morphs.push_back(std::move(morph));
+    }
+    modelGL.meshes.push_back(mesh);
+    return true;
+}
+
+// --- Węzły, których transformacja zmienia się w czasie (cele kanałów animacji) ---
+inline std::vector<bool> FindAnimatedNodes(const tinygltf::Model& model) {
+    std::vector<bool> animated(model.nodes.size(), false);
+    for (const auto& animation : model.animations) {
+        for (const auto& channel : animation.channels) {
+            if (channel.target_node >= 0 && channel.target_node < (int)animated.size()) {
+                animated[channel.target_node] = true;
+            }
+        }
+    }
+    return animated;
+}
+
+// --- Klipy animacji, poza spoczynkowa i graf domyślnej sceny ---
+// Wywoływane przy ładowaniu, póki bufory modelu jeszcze istnieją (discardAfterUpload).
+// Hierarchia i poza powstają także bez animacji, gdy model ma skiny (paleta z macierzy świata
+// stawów) albo morph targety (wagi w NodePose).
+inline void LoadAnimations(const tinygltf::Model& model, int sceneIndex, ModelAnimation& animation) {
+    LOAD_PROFILE_SCOPE("ExtractAnimations");
+    animation = ModelAnimation();
+    ExtractAnimations(model, animation.clips);
+    if (animation.clips.empty() && model.skins.empty() && !HasMorphTargets(model)) return;
+
+    InitNodePose(model, animation.pose);
+    BuildSceneGraph(model, sceneIndex, animation.graph);
+
+    if (animation.clips.empty()) return;
+    std::cout << "Animacje: " << animation.clips.size() << " klipow, kanaly pierwszego: " << animation.clips[0].channels.size()
+              << ", klucze: " << AnimationKeyCount(animation.clips) << ", czas: " << animation.clips[0].Duration() << " s"
+              << std::endl;
+}
+
+// --- Morph targety dla wag z pozy; do GPU idzie tylko zakres zmienionych wierzchołków ---
+inline void UpdateMorphs(ModelGL& modelGL) {
+    const NodePose& pose = modelGL.animation.pose;
+    for (auto& entry : modelGL.morphs) {
+        if (entry.node < 0 || entry.node >= (int)pose.Size()) continue; // Stałe wagi - policzone przy ładowaniu
+        uint32_t begin, end;
+        if (!EvaluateMorph(entry.morph, pose.weights.data() + pose.weightOffset[entry.node], pose.WeightCount(entry.node),
+                           begin, end)) {
+            continue;
+        }
+        const float* range = entry.morph.current.data() + (size_t)begin * 8;
+        const size_t bytes = (size_t)(end - begin) * sizeof(Vertex);
+        if (entry.cpuSkin >= 0) {
+            // Skinning CPU przeliczy VBO z nowej pozy wiązania (UpdateSkins)
+            std::memcpy(reinterpret_cast<float*>(modelGL.cpuSkins[entry.cpuSkin].bindVertices.data() + begin), range, bytes);
+            modelGL.cpuSkins[entry.cpuSkin].version = 0;
+            continue;
+        }
+        glState.BindBuffer(GL_ARRAY_BUFFER, entry.vbo);
+        glBufferSubData(GL_ARRAY_BUFFER, (GLintptr)begin * sizeof(Vertex), bytes, range);
+    }
+}
+
+// --- Palety skinów (po zmianie macierzy świata) i wierzchołki meshy skinowanych na CPU ---
+// Mesh CPU jest przeliczany, gdy zmieniła się paleta albo poza wiązania (morph targety).
+inline void UpdateSkins(ModelGL& modelGL, bool palettes) {
+    const SceneGraph& graph = modelGL.animation.graph;
+    for (auto& skin : modelGL.skins) {
+        // Paleta (i CPU skinning za nią) tylko gdy graf przeliczył któryś staw albo nie była jeszcze liczona
+        if (!palettes || skin.joints.empty()) continue;
+        if (skin.version == 0 || std::any_of(skin.joints.begin(), skin.joints.end(), [&](int joint) { return graph.Updated(joint); })) {
+            ComputeJointPalette(graph, skin);
+        }
+    }
+    for (auto& cpu : modelGL.cpuSkins) {
+        const SkinData& skin = modelGL.skins[cpu.skin];
+        if (cpu.version == skin.version) continue;
+        SkinVerticesCPU(reinterpret_cast<const float*>(cpu.bindVertices.data()), cpu.skinVertices.data(),
+                        cpu.bindVertices.size(), skin.palette.data(), reinterpret_cast<float*>(cpu.skinned.data()));
+        glState.BindBuffer(GL_ARRAY_BUFFER, cpu.vbo);
+        glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(Vertex) * cpu.skinned.size(), cpu.skinned.data());
+        cpu.version = skin.version;
+    }
+}
+
+// --- Krok animacji, macierze świata meshy pod animowanymi węzłami i palety skinów ---
+// Krok to czas od poprzedniej klatki, obcięty do 0.25 s (np. po przełączeniu karty przeglądarki).
+// Do grafu sceny trafiają tylko węzły z kanałami TRS aktywnego klipu (wagi czyta UpdateMorphs).
+// Macierze meshy i palety są odświeżane tylko dla węzłów z przeliczonych poddrzew (także po
+// edycji węzłów przy zatrzymanej animacji).
+inline void UpdateAnimation(ModelGL& modelGL) {
+    ModelAnimation& animation = modelGL.animation;
+    if (animation.graph.Size() == 0) return;
+    const double now = TraceNowUs();
+    const double dt = (animation.lastUs < 0) ? 0.0 : std::min((now - animation.lastUs) / 1e6, 0.25);
+    animation.lastUs = now;
+
+    NodePose& pose = animation.pose;
+    if (playAnimations && animation.player.Advance(animation.clips, dt, pose)) {
+        for (const AnimationChannel& channel : animation.clips[animation.player.clip].channels) {
+            const int node = channel.node;
+            if (channel.path == AnimationPath::Weights) continue;
+            if (!pose.changed[node]) continue; // Kilka kanałów tego samego węzła
+            pose.changed[node] = 0;
+            SetSceneNodeTRS(animation.graph, node, pose.translation[node], pose.rotation[node], pose.scale[node]);
+        }
+    }
+    const bool moved = UpdateSceneGraph(animation.graph) > 0;
+    if (moved) {
+        for (auto& mesh : modelGL.meshes) {
+            if (mesh.instances.empty() && animation.graph.Updated(mesh.node)) mesh.transform = animation.graph.World(mesh.node);
+        }
+    }
+    UpdateMorphs(modelGL);
+    UpdateSkins(modelGL, moved);
+}
+
+// --- Raport błędu kwantyzacji wierzchołków (do sprawdzenia wierności assetu) ---
+inline void PrintQuantizationReport(const QuantizationReport& report) {
+    std::cout << "Kwantyzacja: " << report.vertices << " wierzcholkow, VBO "
+              << report.floatBytes / 1024 << " KB -> " << report.quantizedBytes / 1024 << " KB\n"
+              << "  pozycja: max " << report.maxPositionError << " (" << report.maxPositionErrorRel * 100.0 << "% przekatnej AABB)\n"
+              << "  normalna: max " << report.maxNormalErrorDeg << " st.\n"
+              << "  UV: max " << report.maxTexcoordError << std::endl;
+}
+
+// --- Indeks tekstury bazowego koloru materiału albo -1 ---
+inline int BaseColorTextureIndex(const tinygltf::Model& model, int material) {
+    if (material < 0 || material >= (int)model.materials.size()) return -1;
+    int texture = model.materials[material].pbrMetallicRoughness.baseColorTexture.index;
+    return (texture >= 0 && texture < (int)model.textures.size()) ? texture : -1;
+}
+
+// --- Dekodowanie i upload tekstur czekających w ModelGL::textures ---
+// Tekstury glTF wskazujące ten sam obraz dzielą teksturę GL (sampler nie jest jeszcze
+// uwzględniany). Nieudane wczytanie zostawia białą teksturę, żeby nie próbować co klatkę.
+// W przeglądarce obraz z plikiem .ctex jest biały do końca pobierania (StartCompressedFetch).
+// `timings` (benchmark) sumuje czasy dekodowania i uploadu.
+inline void LoadPendingTextures(const tinygltf::Model& model, ModelGL& modelGL, TextureLoadTimings* timings = nullptr) {
+    LOAD_PROFILE_SCOPE("LoadPendingTextures");
+    std::map<int, GLuint> byImage;
+    for (const auto& entry : modelGL.textures) {
+        if (entry.second != 0) byImage[model.textures[entry.first].source] = entry.second;
+    }
+    for (auto& entry : modelGL.textures) {
+        if (entry.second != 0) continue;
+        const int source = model.textures[entry.first].source;
+        auto shared = byImage.find(source);
+        if (shared != byImage.end()) {
+            entry.second = shared->second;
+            continue;
+        }
+#ifdef __EMSCRIPTEN__
+        if (StartCompressedFetch(model, modelGL, source)) {
+            entry.second = modelGL.whiteTexture; // Do czasu odpowiedzi (FinishCompressedFetch)
+            byImage[source] = entry.second;
+            continue;
+        }
+#endif
+        entry.second = LoadTextureFromGLTF(model, entry.first, timings);
+        if (entry.second == 0) entry.second = modelGL.whiteTexture;
+        byImage[source] = entry.second;
+    }
+    modelGL.texturesPending = false;
+    std::cout << "Pamiec GPU tekstur: " << textureGpuBytes / 1024 << " KB" << std::endl;
+}
+
+// --- Wczytywanie danych z GLTF ---
+// Prymitywy ze statycznych węzłów są transformowane na CPU do przestrzeni świata
+// i scalane po materiale w jeden VBO/EBO (batchStaticMeshes). Mesh wskazywany przez
+// kilka statycznych węzłów jest ładowany raz, z listą macierzy instancji
+// (instanceRepeatedMeshes). Prymitywy pod animowanymi węzłami zostają osobno -
+// z macierzą świata w MeshGL::transform, liczoną co klatkę przez UpdateAnimation.
+inline bool LoadModelToOpenGL(const tinygltf::Model& model, ModelGL& modelGL) {
+    if (model.meshes.empty()) {
+        std::cerr << "Brak meshy w modelu!\n";
+        return false;
+    }
+    LOAD_PROFILE_SCOPE("LoadModelToOpenGL");
+
+    quantizationReport = QuantizationReport();
+    textureGpuBytes = 0;
+
+    // EBO bindowany niżej nie może trafić do VAO, które zostało zbindowane po ostatniej klatce
+    if (glExt.vertexArrayObject) glState.BindVertexArray(0);
+
+    struct Batch {
+        std::vector<Vertex> vertices;
+        std::vector<uint32_t> indices;
+    };
+    std::map<int, Batch> batches; // Materiał -> scalona geometria (układ Vertex jest wspólny)
+    size_t primitiveCount = 0;
+    size_t directCount = 0;
+
+    auto addMesh = [&](int meshIndex, int nodeIndex, const glm::mat4& world, bool dynamic,
+                       const std::vector<glm::mat4>* instances, int skin = -1) {
+        const auto& mesh = model.meshes[meshIndex];
+        if (mesh.primitives.empty()) {
+            std::cerr << "Brak prymitywow w jednym z meshy!\n";
+            return;
+        }
+
+        const std::vector<float> morphWeights = DefaultMorphWeights(model, nodeIndex, meshIndex);
+        for (const auto& primitive : mesh.primitives) {
+            // Skinowany: macierz węzła pomijana, pozycję dają stawy (bez JOINTS_0 / WEIGHTS_0 - jak zwykły mesh)
+            if (skin >= 0 && UploadSkinnedMeshGL(model, primitive, skin, nodeIndex, morphWeights, modelGL)) {
+                ++primitiveCount;
+                continue;
+            }
+            if (!primitive.targets.empty() && !instances &&
+                UploadMorphMeshGL(model, primitive, nodeIndex, world, morphWeights, modelGL)) {
+                ++primitiveCount;
+                continue;
+            }
+            // Prymitywy, których nie transformujemy na CPU, mogą iść prosto z bufferView
+            const bool batched = !instances && batchStaticMeshes && !dynamic;
+            MeshGL direct;
+            if (!batched && uploadBufferViewsDirectly && UploadDirectMeshGL(model, primitive, modelGL, direct)) {
+                if (!instances) {
+                    direct.node = nodeIndex;
+                    direct.transform = world;
+                }
+                modelGL.meshes.push_back(direct);
+                if (instances) AttachInstances(modelGL.meshes.back(), *instances);
+                ++directCount;
+            } else if (instances) {
+                Batch single;
+                if (!AppendPrimitive(model, primitive, glm::mat4(1.0f), single.vertices, single.indices)) continue;
+                size_t first = modelGL.meshes.size();
+                EmitMeshGL(single.vertices, single.indices, primitive.material, -1, glm::mat4(1.0f), modelGL.meshes);
+                for (size_t i = first; i < modelGL.meshes.size(); ++i) AttachInstances(modelGL.meshes[i], *instances);
+            } else if (batchStaticMeshes && !dynamic) {
+                Batch& batch = batches[primitive.material];
+                if (!AppendPrimitive(model, primitive, world, batch.vertices, batch.indices)) continue;
+            } else {
+                Batch single;
+                if (!AppendPrimitive(model, primitive, glm::mat4(1.0f), single.vertices, single.indices)) continue;
+                EmitMeshGL(single.vertices, single.indices, primitive.material, nodeIndex, world, modelGL.meshes);
+            }
+            ++primitiveCount;
+        }
+    };
+
+    if (!model.scenes.empty()) {
+        const int sceneIndex = (model.defaultScene >= 0 && model.defaultScene < (int)model.scenes.size()) ? model.defaultScene : 0;
+        ExtractSkins(model, modelGL.skins);
+        LoadAnimations(model, sceneIndex, modelGL.animation);
+    }
+
+    if (model.scenes.empty()) {
+        // Sama geometria bez hierarchii - każdy mesh raz, w układzie lokalnym
+        for (int i = 0; i < (int)model.meshes.size(); ++i) addMesh(i, -1, glm::mat4(1.0f), false, nullptr);
+    } else {
+        const std::vector<bool> animated = FindAnimatedNodes(model);
+        const int sceneIndex = (model.defaultScene >= 0 && model.defaultScene < (int)model.scenes.size()) ? model.defaultScene : 0;
+
+        // Jawny stos zamiast rekurencji (głębokie hierarchie z eksporterów FBX)
+        struct StackEntry { int node; glm::mat4 parentWorld; bool dynamic; };
+        std::vector<StackEntry> stack;
+        // Odwrócona kolejność na stosie = przejście w kolejności z pliku (pierwsza tekstura jak wcześniej)
+        const auto& roots = model.scenes[sceneIndex].nodes;
+        for (auto it = roots.rbegin(); it != roots.rend(); ++it) stack.push_back({*it, glm::mat4(1.0f), false});
+
+        // Najpierw zbieramy wszystkie wystąpienia meshy, żeby wiedzieć, które się powtarzają
+        struct MeshNode { int mesh; int node; glm::mat4 world; bool dynamic; int skin; };
+        std::vector<MeshNode> meshNodes;
+        std::vector<int> staticUses(model.meshes.size(), 0);
+
+        while (!stack.empty()) {
+            StackEntry entry = stack.back();
+            stack.pop_back();
+            if (entry.node < 0 || entry.node >= (int)model.nodes.size()) continue;
+
+            const auto& node = model.nodes[entry.node];
+            glm::mat4 world = entry.parentWorld * NodeLocalMatrix(node);
+            bool dynamic = entry.dynamic || animated[entry.node];
+
+            if (node.mesh >= 0 && node.mesh < (int)model.meshes.size()) {
+                // Skinowane i z morph targetami są przeliczane co klatkę - bez batchingu i instancingu
+                const int skin = (node.skin >= 0 && node.skin < (int)modelGL.skins.size()) ? node.skin : -1;
+                const bool deformed = skin >= 0 || MeshHasMorphTargets(model.meshes[node.mesh]);
+                meshNodes.push_back({node.mesh, entry.node, world, dynamic || deformed, skin});
+                if (!dynamic && !deformed) ++staticUses[node.mesh];
+            }
+            for (auto it = node.children.rbegin(); it != node.children.rend(); ++it) stack.push_back({*it, world, dynamic});
+        }
+
+        // Grupy instancji: mesh -> macierze świata jego statycznych węzłów. Węzły ze skalą
+        // niejednorodną idą zwykłą ścieżką (batching albo draw z u_normalMatrix), bo shader
+        // instancji przenosi normalne przez mat3(a_instance).
+        auto instanced = [&](const MeshNode& meshNode) { return !meshNode.dynamic && HasUniformScale(meshNode.world); };
+        std::map<int, std::vector<glm::mat4>> instanceGroups;
+        if (instanceRepeatedMeshes) {
+            for (const auto& meshNode : meshNodes) {
+                if (staticUses[meshNode.mesh] > 1 && instanced(meshNode)) {
+                    instanceGroups[meshNode.mesh].push_back(meshNode.world);
+                }
+            }
+            for (auto it = instanceGroups.begin(); it != instanceGroups.end();) {
+                it = (it->second.size() > 1) ? std::next(it) : instanceGroups.erase(it); // Jedna instancja - zwykły mesh
+            }
+        }
+
+        for (const auto& meshNode : meshNodes) {
+            auto group = instanceGroups.find(meshNode.mesh);
+            if (group != instanceGroups.end() && instanced(meshNode)) {
+                if (!group->second.empty()) {
+                    addMesh(meshNode.mesh, -1, glm::mat4(1.0f), false, &group->second);
+                    group->second.clear(); // Grupa ładowana przy pierwszym wystąpieniu
+                }
+                continue;
+            }
+            addMesh(meshNode.mesh, meshNode.node, meshNode.world, meshNode.dynamic, nullptr, meshNode.skin);
+        }
+    }
+
+    for (const auto& batch : batches) {
+        EmitMeshGL(batch.second.vertices, batch.second.indices, batch.first, -1, glm::mat4(1.0f), modelGL.meshes);
+    }
+
+    // Tekstury bazowego koloru: każdy indeks raz, dekodowanie i upload odkładamy do pierwszej klatki
+    for (auto& mesh : modelGL.meshes) {
+        mesh.texture = BaseColorTextureIndex(model, mesh.material);
+        if (mesh.texture >= 0 && modelGL.textures.emplace(mesh.texture, 0).second) modelGL.texturesPending = true;
+    }
+    modelGL.whiteTexture = CreateWhiteTexture();
+
+    // Kolejność rysowania: najpierw program (wariant VBO), potem tekstura - każda zmiana to jeden bind
+    auto program = [](const MeshGL& mesh) { return mesh.skinVbo != 0 ? 2 : mesh.quantized ? 1 : 0; };
+    std::stable_sort(modelGL.meshes.begin(), modelGL.meshes.end(), [&](const MeshGL& a, const MeshGL& b) {
+        return std::make_pair(program(a), a.texture) < std::make_pair(program(b), b.texture);
+    });
+
+    std::cout << "Prymitywy: " << primitiveCount << ", obiekty do rysowania: " << modelGL.meshes.size()
+              << ", draw calle: " << CountDrawCalls(modelGL) << ", tekstury: " << modelGL.textures.size() << std::endl;
+    if (directCount > 0) {
+        std::cout << "Bezposrednio z bufferView: " << directCount << " prymitywow, "
+                  << modelGL.arrayViewBuffers.size() + modelGL.elementViewBuffers.size() << " buforow GL" << std::endl;
+    }
+    if (!modelGL.skins.empty()) {
+        std::cout << "Skiny: " << modelGL.skins.size() << ", meshe skinowane na CPU: " << modelGL.cpuSkins.size() << std::endl;
+    }
+    if (!modelGL.morphs.empty()) {
+        size_t targets = 0, deltas = 0;
+        for (const auto& entry : modelGL.morphs) {
+            targets += entry.morph.targets.size();
+            for (const auto& target : entry.morph.targets) deltas += target.vertices.size();
+        }
+        std::cout << "Morph targety: " << modelGL.morphs.size() << " prymitywow, " << targets << " targetow, " << deltas
+                  << " niezerowych delt" << std::endl;
+    }
+    if (quantizeVertices) PrintQuantizationReport(quantizationReport);
+    SampleHeap(); // Batche (kopie wierzchołków) jeszcze istnieją
+    return !modelGL.meshes.empty();
+}
+
+// --- Widoczność meshy i instancji dla macierzy clip (projekcja * widok * obrót modelu) ---
+// Liczniki widocznych / odrzuconych obiektów trafiają do frameStats.
+inline void CullMeshes(ModelGL& modelGL, const glm::mat4& clip) {
+    BoundingSpheres& spheres = modelGL.spheres;
+    spheres.Clear();
+    modelGL.firstSphere.resize(modelGL.meshes.size() + 1);
+    for (size_t i = 0; i < modelGL.meshes.size(); ++i) {
+        const MeshGL& mesh = modelGL.meshes[i];
+        modelGL.firstSphere[i] = (uint32_t)spheres.count;
+        const size_t count = mesh.instances.empty() ? 1 : mesh.instances.size();
+        for (size_t k = 0; k < count; ++k) {
+            if (!frustumCulling || !mesh.hasBounds) {
+                spheres.PushAlwaysVisible();
+                continue;
+            }
+            glm::vec3 center;
+            float radius;
+            TransformBounds(mesh.instances.empty() ? mesh.transform : mesh.instances[k], mesh.boundsMin, mesh.boundsMax,
+                            center, radius);
+            spheres.Push(center, radius);
+        }
+    }
+    modelGL.firstSphere.back() = (uint32_t)spheres.count;
+
+    FrustumPlanes planes;
+    ExtractFrustumPlanes(clip, planes);
+    const size_t visible = CullSpheres(planes, spheres, modelGL.visible);
+    frameStats.CountCulling((unsigned)visible, (unsigned)(spheres.count - visible));
+}
+
+// --- Czy któraś instancja meshu i jest widoczna (po CullMeshes) ---
+inline bool MeshVisible(const ModelGL& modelGL, size_t i) {
+    for (uint32_t s = modelGL.firstSphere[i]; s < modelGL.firstSphere[i + 1]; ++s) {
+        if (modelGL.visible[s]) return true;
+    }
+    return false;
+}
+
+// --- Zwolnienie obiektów GL modelu (np. przed wczytaniem kolejnego) ---
+inline void ReleaseModelGL(ModelGL& modelGL) {
+    CancelMipmapJobs(); // Wątki liczące mipmapy odwołują się do tekstur modelu
+#ifdef __EMSCRIPTEN__
+    ++compressedFetchGeneration; // Odpowiedzi dla tego modelu nie dotkną już ModelGL
+#endif
+    for (const auto& mesh : modelGL.meshes) {
+        if (mesh.vao != 0) glExt.deleteVertexArrays(1, &mesh.vao);
+        if (mesh.instanceVbo != 0) glDeleteBuffers(1, &mesh.instanceVbo);
+        if (mesh.skinVbo != 0) glDeleteBuffers(1, &mesh.skinVbo);
+        if (mesh.direct) continue; // Bufory bufferView usuwane niżej, raz
+        glDeleteBuffers(1, &mesh.vbo);
+        glDeleteBuffers(1, &mesh.ebo);
+    }
+    for (const auto& entry : modelGL.arrayViewBuffers) glDeleteBuffers(1, &entry.second);
+    for (const auto& entry : modelGL.elementViewBuffers) glDeleteBuffers(1, &entry.second);
+    std::set<GLuint> textures; // Jedna tekstura GL może obsługiwać kilka indeksów glTF
+    for (const auto& entry : modelGL.textures) textures.insert(entry.second);
+    textures.insert(modelGL.whiteTexture);
+    for (GLuint texture : textures) {
+        if (texture != 0) glDeleteTextures(1, &texture);
+    }
+    modelGL = ModelGL();
+    uploadedPaletteSkin = -1;
+    glState.Invalidate(); // Usunięte obiekty były zbindowane, a GL może ponownie użyć ich ID
+}
+
+// --- Jedna klatka: wszystko poza obsługą zdarzeń i zamianą buforów ---
+inline void RenderFrame(int width, int height) {
+    frameStats.BeginGpu();
+    glClearColor(0.1f, 0.1f, 0.2f, 1.0f); // Ustawienie tła na ciemnoniebieskie
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+    glViewport(0, 0, width, height);
+
+    glm::mat4 projection = glm::perspective(glm::radians(45.0f), width / (float)height, 0.1f, 100.0f);
+    glm::mat4 view = glm::lookAt(glm::vec3(0, 0, 5), glm::vec3(0), glm::vec3(0,1,0));
+    glm::mat4 model = glm::mat4(1.0f);
+    model = glm::scale(model, glm::vec3(1.0f));
+
+    // Obrót myszą raz na klatkę na CPU (wcześniej sin/cos i dwie macierze w shaderze dla każdego wierzchołka).
+    // Znaki jak w dawnym shaderze, żeby kierunek przeciągania się nie zmienił.
+    glm::mat4 rotation = glm::rotate(glm::mat4(1.0f), -rotY, glm::vec3(0, 1, 0)) *
+                         glm::rotate(glm::mat4(1.0f), -rotX, glm::vec3(1, 0, 0));
+    glm::mat4 viewProjection = projection * view;
+    glm::mat4 rotatedModel = rotation * model;
+
+    // u_mvp i u_normalMatrix dla macierzy świata draw calla; cache pomija powtórzenia (np. kolejne batche)
+    auto setWorldMatrix = [&](const ShaderGL& shader, const glm::mat4& world) {
+        glm::mat4 fullWorld = rotatedModel * world;
+        glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3(fullWorld)));
+        glState.UniformMatrix4fv(shader.uniformMVPLoc, glm::value_ptr(viewProjection * fullWorld));
+        glState.UniformMatrix3fv(shader.uniformNormalMatrixLoc, glm::value_ptr(normalMatrix));
+    };
+
+    // Leniwe ładowanie tekstur - dopiero gdy naprawdę są potrzebne do rysowania
+    double stage = frameStats.StageBegin();
+    if (myModel.texturesPending) {
+        LoadPendingTextures(gltfModel, myModel);
+        // Wszystkie użyte tekstury są już na GPU (w przeglądarce obrazy czekają na wynik pobierania .ctex)
+        if (discardAfterUpload && myModel.compressedFetchesInFlight == 0) ReleaseModelImages(gltfModel);
+        PrintHeapReport("po uploadzie tekstur");
+    }
+    PumpMipmapUploads(); // Kolejne poziomy mipmap policzone w tle
+    frameStats.StageEnd(kStageTextures, stage);
+    if (!loadProfiler.Reported() && !myModel.texturesPending && myModel.compressedFetchesInFlight == 0 && !MipmapsPending()) {
+        loadProfiler.PrintSummary(std::cout); // Raz na sesję - model gotowy razem z mipmapami
+    }
+
+    stage = frameStats.StageBegin();
+    UpdateAnimation(myModel);
+    frameStats.StageEnd(kStageAnimation, stage);
+
+    // Po animacji - sfery z aktualnych macierzy świata
+    stage = frameStats.StageBegin();
+    CullMeshes(myModel, viewProjection * rotatedModel);
+    frameStats.StageEnd(kStageCulling, stage);
+
+    glState.ActiveTexture(GL_TEXTURE0);
+
+    // Bez podziału etapów cała pętla to jeden pomiar "draw" - 2 odczyty zegara zamiast 4 na draw call
+    const bool detailed = frameStats.DetailedStages();
+    const double loopBegin = detailed ? 0 : frameStats.StageBegin();
+    auto beginMeshStage = [&]() {
+        if (detailed) stage = frameStats.StageBegin();
+    };
+    auto uniformsDone = [&]() {
+        if (!detailed) return;
+        frameStats.StageEnd(kStageUniforms, stage);
+        stage = frameStats.StageBegin();
+    };
+    auto drawDone = [&]() {
+        if (detailed) frameStats.StageEnd(kStageDraw, stage);
+    };
+
+    for (size_t meshIndex = 0; meshIndex < myModel.meshes.size(); ++meshIndex) {
+        // Instancing sprzętowy rysuje całą grupę, gdy widoczna jest choć jedna instancja
+        if (!MeshVisible(myModel, meshIndex)) continue;
+        const MeshGL& mesh = myModel.meshes[meshIndex];
+        beginMeshStage();
+        // Program wg formatu VBO; uniformy przez cache, więc przy tym samym programie to same pominięcia
+        const bool gpuSkinned = mesh.skinVbo != 0;
+        const ShaderGL& shader = gpuSkinned ? skinnedShader : mesh.quantized ? quantizedShader : floatShader;
+        glState.UseProgram(shader.program);
+        if (gpuSkinned) {
+            const SkinData& skin = myModel.skins[mesh.skin];
+            if (uploadedPaletteSkin != mesh.skin || uploadedPaletteVersion != skin.version) {
+                glUniform4fv(shader.uniformJointsLoc, (GLsizei)skin.JointCount() * 3, skin.palette.data());
+                uploadedPaletteSkin = mesh.skin;
+                uploadedPaletteVersion = skin.version;
+            }
+        }
+        glState.Uniform1i(shader.uniformTextureLoc, 0);
+        if (mesh.quantized) {
+            glState.Uniform3fv(shader.uniformPositionScaleLoc, glm::value_ptr(mesh.quantization.positionScale));
+            glState.Uniform3fv(shader.uniformPositionOffsetLoc, glm::value_ptr(mesh.quantization.positionOffset));
+            glState.Uniform4fv(shader.uniformTexcoordTransformLoc, glm::value_ptr(mesh.quantization.texcoordTransform));
+        }
+        setWorldMatrix(shader, mesh.transform);
+
+        // Meshe są posortowane po teksturze - kolejne z tą samą to pominięcia w cache
+        auto texture = myModel.textures.find(mesh.texture);
+        glState.BindTexture(GL_TEXTURE_2D, (texture != myModel.textures.end()) ? texture->second : myModel.whiteTexture);
+
+        if (mesh.vao != 0) {
+            glState.BindVertexArray(mesh.vao);
+        } else if (mesh.direct) {
+            glState.BindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.ebo);
+            SetupDirectAttributes(mesh);
+        } else {
+            glState.BindBuffer(GL_ARRAY_BUFFER, mesh.vbo);
+            glState.BindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.ebo);
+            SetupVertexAttributes(mesh.quantized);
+            if (gpuSkinned) {
+                glState.BindBuffer(GL_ARRAY_BUFFER, mesh.skinVbo);
+                SetupSkinAttributes();
+            }
+        }
+        const void* indexOffset = (const void*)mesh.indexOffset;
+
+        if (gpuSkinned) {
+            // Stawy na lokalizacjach a_instance - po rysowaniu stała a_instance jest nieokreślona
+            uniformsDone();
+            glDrawElements(GL_TRIANGLES, mesh.indexCount, mesh.indexType, indexOffset);
+            frameStats.CountDraw(mesh.indexCount);
+            if (mesh.vao == 0) DisableSkinAttributes();
+            instanceAttribDirty = true;
+            drawDone();
+            continue;
+        }
+
+        if (mesh.instanceVbo != 0) {
+            // Instancing sprzętowy: jeden draw na grupę, macierze ze strumienia a_instance
+            if (mesh.vao == 0) {
+                glState.BindBuffer(GL_ARRAY_BUFFER, mesh.instanceVbo);
+                SetupInstanceAttributes();
+            }
+            uniformsDone();
+            glExt.drawElementsInstanced(GL_TRIANGLES, mesh.indexCount, mesh.indexType, indexOffset, (GLsizei)mesh.instances.size());
+            frameStats.CountDraw(mesh.indexCount, (GLsizei)mesh.instances.size());
+            if (mesh.vao == 0) DisableInstanceAttributes();
+            instanceAttribDirty = true;
+            drawDone();
+            continue;
+        }
+
+        if (instanceAttribDirty) SetInstanceAttributeIdentity();
+        uniformsDone();
+
+        if (mesh.instances.empty()) {
+            glDrawElements(GL_TRIANGLES, mesh.indexCount, mesh.indexType, indexOffset);
+            frameStats.CountDraw(mesh.indexCount);
+        } else {
+            // Fallback bez instancingu: ta sama geometria, macierz instancji wliczona w u_mvp
+            for (size_t k = 0; k < mesh.instances.size(); ++k) {
+                if (!myModel.visible[myModel.firstSphere[meshIndex] + k]) continue;
+                setWorldMatrix(shader, mesh.instances[k]);
+                glDrawElements(GL_TRIANGLES, mesh.indexCount, mesh.indexType, indexOffset);
+                frameStats.CountDraw(mesh.indexCount);
+            }
+        }
+        drawDone();
+    }
+    if (!detailed) frameStats.StageEnd(kStageDraw, loopBegin);
+    frameStats.EndGpu();
+}
+
+#endif  // RENDERER_H_
@@ -0,0 +1,263 @@
+// Spłaszczona hierarchia sceny glTF. Węzły leżą w kolejności DFS (rodzic przed
+// dziećmi, poddrzewo węzła i to ciągły przedział [i, subtreeEnd[i])) w tablicach SoA:
+// indeks rodzica, lokalne TRS / macierz i zapamiętana macierz świata.
+//
+// Zmiana pozy (animacja, edycja) oznacza węzeł jako brudny, a UpdateSceneGraph
+// przelicza tylko poddrzewa brudnych węzłów - koszt rośnie z liczbą zmienionych
+// węzłów i ich potomków, nie z rozmiarem sceny. Przeliczone pozycje dostają numer
+// aktualizacji (updatedIn), więc odbiorcy (meshe, palety skinów) odświeżają tylko to,
+// co leży w zmienionych poddrzewach. Mnożenie rodzic * lokalna ma wersje SSE2 / WASM
+// SIMD128 i skalarną.
+#ifndef SCENE_GRAPH_H_
+#define SCENE_GRAPH_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "tiny_gltf.h"
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define SCENE_GRAPH_SSE2 1
+#elif defined(__wasm_simd128__)
+#include <wasm_simd128.h>
+#define SCENE_GRAPH_WASM_SIMD 1
+#endif
+
+struct SceneGraph {
+    // Indeksowane pozycją w kolejności DFS
+    std::vector<int> node;            // Węzeł glTF
+    std::vector<int> parent;          // Pozycja rodzica, -1 = korzeń sceny
+    std::vector<uint32_t> subtreeEnd; // Poddrzewo pozycji i: [i, subtreeEnd[i])
+    std::vector<glm::vec3> translation;
+    std::vector<glm::vec4> rotation;  // Kwaternion x, y, z, w (kolejność glTF)
+    std::vector<glm::vec3> scale;
+    std::vector<uint8_t> hasMatrix;   // Lokalna z `matrix` - TRS nie jest używane
+    std::vector<glm::mat4> local;
+    std::vector<glm::mat4> world;
+    std::vector<uint8_t> dirty;       // local do przeliczenia z TRS
+    std::vector<uint32_t> dirtyList;  // Pozycje z dirty (bez powtórzeń)
+    std::vector<uint32_t> updatedIn;  // Numer aktualizacji, w której przeliczono world
+    uint32_t update = 0;              // Numer ostatniego UpdateSceneGraph
+
+    std::vector<int> position;        // Węzeł glTF -> pozycja, -1 = poza sceną
+
+    size_t Size() const { return node.size(); }
+
+    // Macierz świata węzła glTF; węzeł spoza sceny - jednostkowa
+    const glm::mat4& World(int gltfNode) const {
+        static const glm::mat4 identity(1.0f);
+        const int p = (gltfNode >= 0 && gltfNode < (int)position.size()) ? position[gltfNode] : -1;
+        return (p < 0) ? identity : world[p];
+    }
+
+    // Czy ostatnie UpdateSceneGraph przeliczyło macierz świata węzła glTF
+    bool Updated(int gltfNode) const {
+        const int p = (gltfNode >= 0 && gltfNode < (int)position.size()) ? position[gltfNode] : -1;
+        return p >= 0 && updatedIn[p] == update;
+    }
+};
+
+// --- Macierz lokalna węzła: matrix albo translation * rotation * scale ---
+inline glm::mat4 NodeLocalMatrix(const tinygltf::Node& node) {
+    if (node.matrix.size() == 16) {
+        glm::mat4 m;
+        for (int i = 0; i < 16; ++i) glm::value_ptr(m)[i] = (float)node.matrix[i]; // glTF też jest kolumnowy
+        return m;
+    }
+    glm::mat4 m(1.0f);
+    if (node.translation.size() == 3) {
+        m = glm::translate(m, glm::vec3(node.translation[0], node.translation[1], node.translation[2]));
+    }
+    if (node.rotation.size() == 4) {
+        glm::quat q((float)node.rotation[3], (float)node.rotation[0], (float)node.rotation[1], (float)node.rotation[2]);
+        m = m * glm::mat4_cast(q);
+    }
+    if (node.scale.size() == 3) {
+        m = glm::scale(m, glm::vec3(node.scale[0], node.scale[1], node.scale[2]));
+    }
+    return m;
+}
+
+namespace scene_detail {
+
+inline glm::mat4 ComposeTRS(const glm::vec3& t, const glm::vec4& r, const glm::vec3& s) {
+    glm::mat4 m = glm::mat4_cast(glm::quat(r.w, r.x, r.y, r.z));
+    m[0] *= s.x;
+    m[1] *= s.y;
+    m[2] *= s.z;
+    m[3] = glm::vec4(t, 1.0f);
+    return m;
+}
+
+// out = a * b, macierze kolumnowe: kolumna j = suma a.kolumna[k] * b[j][k]
+inline void MultiplyScalar(const float* a, const float* b, float* out) {
+    for (int j = 0; j < 4; ++j) {
+        for (int r = 0; r < 4; ++r) {
+            out[j * 4 + r] = a[r] * b[j * 4] + a[4 + r] * b[j * 4 + 1] + a[8 + r] * b[j * 4 + 2] + a[12 + r] * b[j * 4 + 3];
+        }
+    }
+}
+
+#if defined(SCENE_GRAPH_SSE2)
+inline void Multiply(const float* a, const float* b, float* out) {
+    const __m128 a0 = _mm_loadu_ps(a), a1 = _mm_loadu_ps(a + 4), a2 = _mm_loadu_ps(a + 8), a3 = _mm_loadu_ps(a + 12);
+    for (int j = 0; j < 4; ++j) {
+        const float* col = b + j * 4;
+        __m128 c = _mm_add_ps(_mm_mul_ps(a0, _mm_set1_ps(col[0])), _mm_mul_ps(a1, _mm_set1_ps(col[1])));
+        c = _mm_add_ps(c, _mm_add_ps(_mm_mul_ps(a2, _mm_set1_ps(col[2])), _mm_mul_ps(a3, _mm_set1_ps(col[3]))));
+        _mm_storeu_ps(out + j * 4, c);
+    }
+}
+#elif defined(SCENE_GRAPH_WASM_SIMD)
+inline void Multiply(const float* a, const float* b, float* out) {
+    const v128_t a0 = wasm_v128_load(a), a1 = wasm_v128_load(a + 4), a2 = wasm_v128_load(a + 8), a3 = wasm_v128_load(a + 12);
+    for (int j = 0; j < 4; ++j) {
+        const float* col = b + j * 4;
+        v128_t c = wasm_f32x4_add(wasm_f32x4_mul(a0, wasm_f32x4_splat(col[0])), wasm_f32x4_mul(a1, wasm_f32x4_splat(col[1])));
+        c = wasm_f32x4_add(c, wasm_f32x4_add(wasm_f32x4_mul(a2, wasm_f32x4_splat(col[2])),
+                                             wasm_f32x4_mul(a3, wasm_f32x4_splat(col[3]))));
+        wasm_v128_store(out + j * 4, c);
+    }
+}
+#else
+inline void Multiply(const float* a, const float* b, float* out) { MultiplyScalar(a, b, out); }
+#endif
+
+}  // namespace scene_detail
+
+// --- Oznaczenie węzła (pozycji) do przeliczenia; poddrzewo zostanie przeliczone w UpdateSceneGraph ---
+inline void MarkSceneNodeDirty(SceneGraph& graph, uint32_t position) {
+    if (graph.dirty[position]) return;
+    graph.dirty[position] = 1;
+    graph.dirtyList.push_back(position);
+}
+
+// --- Nowe lokalne TRS węzła glTF (animacja, edycja); false dla węzłów spoza sceny i z `matrix` ---
+inline bool SetSceneNodeTRS(SceneGraph& graph, int gltfNode, const glm::vec3& translation, const glm::vec4& rotation,
+                            const glm::vec3& scale) {
+    if (gltfNode < 0 || gltfNode >= (int)graph.position.size()) return false;
+    const int p = graph.position[gltfNode];
+    if (p < 0 || graph.hasMatrix[p]) return false;
+    graph.translation[p] = translation;
+    graph.rotation[p] = rotation;
+    graph.scale[p] = scale;
+    MarkSceneNodeDirty(graph, (uint32_t)p);
+    return true;
+}
+
+// --- Spłaszczenie sceny sceneIndex; węzeł odwiedzony drugi raz (błędny plik) jest pomijany ---
+// Macierze świata policzy pierwsze UpdateSceneGraph (korzenie są oznaczone jako brudne).
+inline void BuildSceneGraph(const tinygltf::Model& model, int sceneIndex, SceneGraph& graph) {
+    graph = SceneGraph();
+    const size_t count = model.nodes.size();
+    graph.position.assign(count, -1);
+    if (sceneIndex < 0 || sceneIndex >= (int)model.scenes.size()) return;
+
+    // Jawny stos (głębokie hierarchie); odwrócona kolejność = dzieci w kolejności z pliku
+    struct Entry { int node; int parent; };
+    std::vector<Entry> stack;
+    const auto& roots = model.scenes[sceneIndex].nodes;
+    for (auto it = roots.rbegin(); it != roots.rend(); ++it) stack.push_back({*it, -1});
+    while (!stack.empty()) {
+        const Entry entry = stack.back();
+        stack.pop_back();
+        if (entry.node < 0 || entry.node >= (int)count || graph.position[entry.node] >= 0) continue;
+        const int p = (int)graph.node.size();
+        graph.position[entry.node] = p;
+        graph.node.push_back(entry.node);
+        graph.parent.push_back(entry.parent);
+        const auto& children = model.nodes[entry.node].children;
+        for (auto it = children.rbegin(); it != children.rend(); ++it) stack.push_back({*it, p});
+    }
+
+    const size_t size = graph.node.size();
+    graph.subtreeEnd.resize(size);
+    for (size_t i = 0; i < size; ++i) graph.subtreeEnd[i] = (uint32_t)i + 1;
+    // Dzieci leżą za rodzicem, więc przejście od końca domyka poddrzewa od liści
+    for (size_t i = size; i-- > 0;) {
+        if (graph.parent[i] >= 0) graph.subtreeEnd[graph.parent[i]] = std::max(graph.subtreeEnd[graph.parent[i]], graph.subtreeEnd[i]);
+    }
+
+    graph.translation.assign(size, glm::vec3(0.0f));
+    graph.rotation.assign(size, glm::vec4(0.0f, 0.0f, 0.0f, 1.0f));
+    graph.scale.assign(size, glm::vec3(1.0f));
+    graph.hasMatrix.assign(size, 0);
+    graph.local.resize(size);
+    graph.world.assign(size, glm::mat4(1.0f));
+    graph.dirty.assign(size, 0);
+    graph.updatedIn.assign(size, 0);
+    for (size_t i = 0; i < size; ++i) {
+        const auto& node = model.nodes[graph.node[i]];
+        graph.hasMatrix[i] = node.matrix.size() == 16;
+        if (node.translation.size() == 3) graph.translation[i] = glm::vec3(node.translation[0], node.translation[1], node.translation[2]);
+        if (node.rotation.size() == 4) {
+            graph.rotation[i] = glm::vec4(node.rotation[0], node.rotation[1], node.rotation[2], node.rotation[3]);
+        }
+        if (node.scale.size() == 3) graph.scale[i] = glm::vec3(node.scale[0], node.scale[1], node.scale[2]);
+        graph.local[i] = NodeLocalMatrix(node);
+        if (graph.parent[i] < 0) MarkSceneNodeDirty(graph, (uint32_t)i);
+    }
+}
+
+namespace scene_detail {
+
+// Lokalna z TRS (gdy brudna) i macierz świata pozycji i - rodzic jest już aktualny
+template <bool kSimd>
+inline void UpdateNode(SceneGraph& graph, uint32_t i) {
+    if (graph.dirty[i]) {
+        if (!graph.hasMatrix[i]) graph.local[i] = ComposeTRS(graph.translation[i], graph.rotation[i], graph.scale[i]);
+        graph.dirty[i] = 0;
+    }
+    graph.updatedIn[i] = graph.update;
+    const int parent = graph.parent[i];
+    if (parent < 0) {
+        graph.world[i] = graph.local[i];
+    } else if (kSimd) {
+        Multiply(glm::value_ptr(graph.world[parent]), glm::value_ptr(graph.local[i]), glm::value_ptr(graph.world[i]));
+    } else {
+        MultiplyScalar(glm::value_ptr(graph.world[parent]), glm::value_ptr(graph.local[i]), glm::value_ptr(graph.world[i]));
+    }
+}
+
+}  // namespace scene_detail
+
+// --- Przeliczenie poddrzew brudnych węzłów; zwraca liczbę przeliczonych macierzy świata ---
+// Przy wielu zmianach (ponad 1/8 węzłów) jedno liniowe przejście ze znacznikiem rodzica jest
+// tańsze niż sortowanie listy brudnych.
+template <bool kSimd = true>
+inline size_t UpdateSceneGraph(SceneGraph& graph) {
+    ++graph.update; // Znaczniki poprzedniej aktualizacji tracą ważność bez czyszczenia
+    if (graph.dirtyList.empty()) return 0;
+    size_t updated = 0;
+    if (graph.dirtyList.size() * 8 > graph.Size()) {
+        for (uint32_t i = 0; i < (uint32_t)graph.Size(); ++i) {
+            const int parent = graph.parent[i];
+            if (!graph.dirty[i] && (parent < 0 || graph.updatedIn[parent] != graph.update)) continue;
+            scene_detail::UpdateNode<kSimd>(graph, i);
+            ++updated;
+        }
+        graph.dirtyList.clear();
+        return updated;
+    }
+
+    // Rosnąco: poddrzewo wcześniejszego węzła obejmuje brudnych potomków, ich dirty obsłuży ta sama pętla
+    std::sort(graph.dirtyList.begin(), graph.dirtyList.end());
+    uint32_t covered = 0;
+    for (uint32_t first : graph.dirtyList) {
+        if (first < covered) continue;
+        const uint32_t end = graph.subtreeEnd[first];
+        for (uint32_t i = first; i < end; ++i) scene_detail::UpdateNode<kSimd>(graph, i);
+        updated += end - first;
+        covered = end;
+    }
+    graph.dirtyList.clear();
+    return updated;
+}
+
+#endif  // SCENE_GRAPH_H_
@@ -0,0 +1,226 @@
+// Skinning glTF: macierze odwrotne wiązania (inverseBindMatrices) czytane raz przy
+// ładowaniu, a co klatkę paleta stawów world[staw] * IBM w płaskiej tablicy -
+// 3 wiersze macierzy afinicznej (12 floatów) na staw, w układzie uniform vec4
+// u_joints[] shadera SKINNED. Macierz węzła, do którego podpięty jest mesh, jest
+// pomijana (wymóg glTF) - paleta zawiera już przestrzeń świata.
+//
+// Paleta i mieszanie macierzy w skinningu CPU (fallback, gdy stawów jest więcej,
+// niż zmieści się w uniformach GLES2) mają wersje SSE2 / WASM SIMD128 i skalarną.
+#ifndef SKINNING_H_
+#define SKINNING_H_
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#include "accessor_reader.h"
+#include "scene_graph.h"
+#include "tiny_gltf.h"
+#include <glm/glm.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define SKINNING_SSE2 1
+#elif defined(__wasm_simd128__)
+#include <wasm_simd128.h>
+#define SKINNING_WASM_SIMD 1
+#endif
+
+struct SkinData {
+    std::vector<int> joints;          // Węzły stawów
+    std::vector<float> inverseBind;   // 16 floatów na staw, wierszami (paleta mnoży przez wiersze)
+    std::vector<float> palette;       // 12 floatów na staw: wiersze 0..2 macierzy świata stawu
+    unsigned version = 0;             // Zwiększane przy każdym przeliczeniu palety
+
+    size_t JointCount() const { return joints.size(); }
+};
+
+// Strumień skinningu obok Vertex (osobny VBO): indeksy stawów i wagi
+struct SkinVertex {
+    uint16_t joints[4];
+    float weights[4];
+};
+
+// --- Skiny modelu; IBM brakujące w pliku = jednostkowe ---
+inline bool ExtractSkins(const tinygltf::Model& model, std::vector<SkinData>& skins) {
+    skins.assign(model.skins.size(), SkinData());
+    for (size_t s = 0; s < model.skins.size(); ++s) {
+        const auto& source = model.skins[s];
+        SkinData& skin = skins[s];
+        for (int joint : source.joints) {
+            if (joint < 0 || joint >= (int)model.nodes.size()) {
+                std::cerr << "Skin " << s << ": staw poza zakresem wezlow\n";
+                skins[s] = SkinData();
+                break;
+            }
+            skin.joints.push_back(joint);
+        }
+
+        std::vector<float> matrices;
+        const int ibm = source.inverseBindMatrices;
+        if (ibm >= 0 && ibm < (int)model.accessors.size() && (!ReadAccessor(model, model.accessors[ibm], matrices, 16) ||
+                                                             matrices.size() < skin.joints.size() * 16)) {
+            std::cerr << "Skin " << s << ": nie mozna odczytac inverseBindMatrices\n";
+            matrices.clear();
+        }
+        skin.inverseBind.resize(skin.joints.size() * 16);
+        for (size_t j = 0; j < skin.joints.size(); ++j) {
+            float* rows = skin.inverseBind.data() + j * 16;
+            for (int r = 0; r < 4; ++r) {
+                for (int c = 0; c < 4; ++c) {
+                    // glTF jest kolumnowy: element (r, c) to matrices[c * 4 + r]
+                    rows[r * 4 + c] = matrices.empty() ? (r == c ? 1.0f : 0.0f) : matrices[j * 16 + c * 4 + r];
+                }
+            }
+        }
+        skin.palette.assign(skin.joints.size() * 12, 0.0f);
+    }
+    return !skins.empty();
+}
+
+// --- Strumień SkinVertex z JOINTS_0 / WEIGHTS_0; wagi normalizowane do sumy 1 ---
+inline bool ReadSkinVertices(const tinygltf::Model& model, const tinygltf::Primitive& primitive, size_t jointCount,
+                             std::vector<SkinVertex>& out) {
+    auto joints = primitive.attributes.find("JOINTS_0");
+    auto weights = primitive.attributes.find("WEIGHTS_0");
+    if (joints == primitive.attributes.end() || weights == primitive.attributes.end()) return false;
+    const int accessorCount = (int)model.accessors.size();
+    if (joints->second < 0 || joints->second >= accessorCount || weights->second < 0 || weights->second >= accessorCount) {
+        return false;
+    }
+    std::vector<float> j, w;
+    if (!ReadAccessor(model, model.accessors[joints->second], j, 4) ||
+        !ReadAccessor(model, model.accessors[weights->second], w, 4) || j.size() != w.size()) {
+        return false;
+    }
+    out.resize(j.size() / 4);
+    for (size_t v = 0; v < out.size(); ++v) {
+        float sum = 0.0f;
+        for (int i = 0; i < 4; ++i) {
+            const uint32_t joint = (uint32_t)j[v * 4 + i];
+            const bool valid = joint < jointCount; // Waga dla stawu spoza skina jest odrzucana
+            out[v].joints[i] = valid ? (uint16_t)joint : 0;
+            out[v].weights[i] = valid ? std::max(w[v * 4 + i], 0.0f) : 0.0f;
+            sum += out[v].weights[i];
+        }
+        for (int i = 0; i < 4; ++i) out[v].weights[i] = (sum > 0.0f) ? out[v].weights[i] / sum : (i == 0 ? 1.0f : 0.0f);
+    }
+    return true;
+}
+
+namespace skin_detail {
+
+// Wiersz r macierzy world * IBM: suma world[k][r] * (wiersz k IBM)
+inline void PaletteJointScalar(const float* world, const float* ibmRows, float* out) {
+    for (int r = 0; r < 3; ++r) {
+        for (int c = 0; c < 4; ++c) {
+            out[r * 4 + c] = world[r] * ibmRows[c] + world[4 + r] * ibmRows[4 + c] + world[8 + r] * ibmRows[8 + c] +
+                             world[12 + r] * ibmRows[12 + c];
+        }
+    }
+}
+
+// Macierz stawów wierzchołka: suma waga * wiersze palety (12 floatów)
+inline void BlendJointsScalar(const SkinVertex& skin, const float* palette, float* rows) {
+    for (int i = 0; i < 12; ++i) rows[i] = 0.0f;
+    for (int k = 0; k < 4; ++k) {
+        const float weight = skin.weights[k];
+        if (weight == 0.0f) continue;
+        const float* joint = palette + skin.joints[k] * 12;
+        for (int i = 0; i < 12; ++i) rows[i] += weight * joint[i];
+    }
+}
+
+#if defined(SKINNING_SSE2)
+inline void PaletteJoint(const float* world, const float* ibmRows, float* out) {
+    const __m128 b0 = _mm_loadu_ps(ibmRows), b1 = _mm_loadu_ps(ibmRows + 4);
+    const __m128 b2 = _mm_loadu_ps(ibmRows + 8), b3 = _mm_loadu_ps(ibmRows + 12);
+    for (int r = 0; r < 3; ++r) {
+        __m128 row = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(world[r]), b0), _mm_mul_ps(_mm_set1_ps(world[4 + r]), b1));
+        row = _mm_add_ps(row, _mm_add_ps(_mm_mul_ps(_mm_set1_ps(world[8 + r]), b2), _mm_mul_ps(_mm_set1_ps(world[12 + r]), b3)));
+        _mm_storeu_ps(out + r * 4, row);
+    }
+}
+
+inline void BlendJoints(const SkinVertex& skin, const float* palette, float* rows) {
+    __m128 r0 = _mm_setzero_ps(), r1 = _mm_setzero_ps(), r2 = _mm_setzero_ps();
+    for (int k = 0; k < 4; ++k) {
+        if (skin.weights[k] == 0.0f) continue;
+        const __m128 weight = _mm_set1_ps(skin.weights[k]);
+        const float* joint = palette + skin.joints[k] * 12;
+        r0 = _mm_add_ps(r0, _mm_mul_ps(weight, _mm_loadu_ps(joint)));
+        r1 = _mm_add_ps(r1, _mm_mul_ps(weight, _mm_loadu_ps(joint + 4)));
+        r2 = _mm_add_ps(r2, _mm_mul_ps(weight, _mm_loadu_ps(joint + 8)));
+    }
+    _mm_storeu_ps(rows, r0);
+    _mm_storeu_ps(rows + 4, r1);
+    _mm_storeu_ps(rows + 8, r2);
+}
+#elif defined(SKINNING_WASM_SIMD)
+inline void PaletteJoint(const float* world, const float* ibmRows, float* out) {
+    const v128_t b0 = wasm_v128_load(ibmRows), b1 = wasm_v128_load(ibmRows + 4);
+    const v128_t b2 = wasm_v128_load(ibmRows + 8), b3 = wasm_v128_load(ibmRows + 12);
+    for (int r = 0; r < 3; ++r) {
+        v128_t row = wasm_f32x4_add(wasm_f32x4_mul(wasm_f32x4_splat(world[r]), b0), wasm_f32x4_mul(wasm_f32x4_splat(world[4 + r]), b1));
+        row = wasm_f32x4_add(row, wasm_f32x4_add(wasm_f32x4_mul(wasm_f32x4_splat(world[8 + r]), b2),
+                                                 wasm_f32x4_mul(wasm_f32x4_splat(world[12 + r]), b3)));
+        wasm_v128_store(out + r * 4, row);
+    }
+}
+
+inline void BlendJoints(const SkinVertex& skin, const float* palette, float* rows) {
+    v128_t r0 = wasm_f32x4_splat(0.0f), r1 = r0, r2 = r0;
+    for (int k = 0; k < 4; ++k) {
+        if (skin.weights[k] == 0.0f) continue;
+        const v128_t weight = wasm_f32x4_splat(skin.weights[k]);
+        const float* joint = palette + skin.joints[k] * 12;
+        r0 = wasm_f32x4_add(r0, wasm_f32x4_mul(weight, wasm_v128_load(joint)));
+        r1 = wasm_f32x4_add(r1, wasm_f32x4_mul(weight, wasm_v128_load(joint + 4)));
+        r2 = wasm_f32x4_add(r2, wasm_f32x4_mul(weight, wasm_v128_load(joint + 8)));
+    }
+    wasm_v128_store(rows, r0);
+    wasm_v128_store(rows + 4, r1);
+    wasm_v128_store(rows + 8, r2);
+}
+#else
+inline void PaletteJoint(const float* world, const float* ibmRows, float* out) { PaletteJointScalar(world, ibmRows, out); }
+inline void BlendJoints(const SkinVertex& skin, const float* palette, float* rows) { BlendJointsScalar(skin, palette, rows); }
+#endif
+
+}  // namespace skin_detail
+
+// --- Paleta stawów z macierzy świata węzłów grafu sceny ---
+inline void ComputeJointPalette(const SceneGraph& graph, SkinData& skin) {
+    for (size_t j = 0; j < skin.joints.size(); ++j) {
+        skin_detail::PaletteJoint(glm::value_ptr(graph.World(skin.joints[j])), skin.inverseBind.data() + j * 16,
+                                  skin.palette.data() + j * 12);
+    }
+    ++skin.version;
+}
+
+// --- Skinning na CPU: wierzchołki po 8 floatów (pozycja, normalna, UV) jak Vertex ---
+inline void SkinVerticesCPU(const float* bindVertices, const SkinVertex* skin, size_t count, const float* palette,
+                            float* out) {
+    for (size_t v = 0; v < count; ++v) {
+        const float* src = bindVertices + v * 8;
+        float* dst = out + v * 8;
+        float m[12];
+        skin_detail::BlendJoints(skin[v], palette, m);
+        float n[3];
+        for (int r = 0; r < 3; ++r) {
+            dst[r] = m[r * 4] * src[0] + m[r * 4 + 1] * src[1] + m[r * 4 + 2] * src[2] + m[r * 4 + 3];
+            n[r] = m[r * 4] * src[3] + m[r * 4 + 1] * src[4] + m[r * 4 + 2] * src[5];
+        }
+        const float length = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+        const float inv = (length > 0.0f) ? 1.0f / length : 0.0f;
+        for (int r = 0; r < 3; ++r) dst[3 + r] = n[r] * inv;
+        dst[6] = src[6];
+        dst[7] = src[7];
+    }
+}
+
+#endif  // SKINNING_H_
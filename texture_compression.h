@@ -0,0 +1,477 @@
+// Tekstury skompresowane na GPU: S3TC (DXT1 / DXT5) i ETC1 przez glCompressedTexImage2D.
+// DXT1 i ETC1 to 4 bity na piksel (8x mniej niż RGBA8), DXT5 8 bitów (4x mniej).
+//
+// Kodowanie jest za wolne na czas ładowania w przeglądarce, więc robi je narzędzie
+// encode_textures.cpp (offline albo przy pierwszym uruchomieniu natywnie), a wynik trafia
+// do pamięci podręcznej na dysku: plik na obraz i rodzinę formatów, nazwany hashem
+// skompresowanych bajtów PNG/JPEG z GLB. Renderer przy ładowaniu tekstury szuka pliku
+// dla formatu obsługiwanego przez GPU i pomija wtedy dekodowanie obrazu i liczenie mipmap.
+// W przeglądarce ten plik jest pobierany przez HTTP dopiero przy ładowaniu tekstury.
+//
+// Koder to prosta wersja jakości "szybkiej": DXT1 - oś główna bloku (PCA), ETC1 - średnie
+// podbloków w trybie indywidualnym lub różnicowym i pełny przegląd tablic modyfikatorów.
+#ifndef TEXTURE_COMPRESSION_H_
+#define TEXTURE_COMPRESSION_H_
+
+#include <GLES2/gl2.h>
+#include <GLES2/gl2ext.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "gl_ext.h"
+#include "gl_state.h"
+#include "texture_mipmaps.h"
+
+#ifndef GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
+#endif
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+#ifndef GL_ETC1_RGB8_OES
+#define GL_ETC1_RGB8_OES 0x8D64
+#endif
+
+// Rodzina formatów = rozszerzenie GPU; S3TC wybiera DXT1 albo DXT5 zależnie od kanału alfa
+enum class CompressedFamily { S3TC, ETC1 };
+
+struct CompressedLevel {
+    int width = 0;
+    int height = 0;
+    std::vector<unsigned char> data;
+};
+
+struct CompressedTexture {
+    GLenum format = 0;
+    std::vector<CompressedLevel> levels; // levels[0] = pełny rozmiar
+};
+
+namespace texcomp_detail {
+
+// Blok 4x4 RGBA; piksele poza obrazem (krawędź NPOT, poziomy 2x2 i 1x1) powielają ostatni wiersz/kolumnę
+inline void FetchBlock(const MipLevel& level, int components, int bx, int by, unsigned char block[16][4]) {
+    for (int y = 0; y < 4; ++y) {
+        const int sy = std::min(by * 4 + y, level.height - 1);
+        for (int x = 0; x < 4; ++x) {
+            const int sx = std::min(bx * 4 + x, level.width - 1);
+            const unsigned char* p = level.pixels.data() + ((size_t)sy * level.width + sx) * components;
+            unsigned char* out = block[y * 4 + x];
+            out[0] = p[0];
+            out[1] = components >= 3 ? p[1] : p[0];
+            out[2] = components >= 3 ? p[2] : p[0];
+            out[3] = components == 4 ? p[3] : 255;
+        }
+    }
+}
+
+inline int Clamp255(int v) { return v < 0 ? 0 : (v > 255 ? 255 : v); }
+
+inline uint16_t Pack565(const float c[3]) {
+    const int r = (int)std::lround(std::min(std::max(c[0], 0.0f), 255.0f) * 31.0f / 255.0f);
+    const int g = (int)std::lround(std::min(std::max(c[1], 0.0f), 255.0f) * 63.0f / 255.0f);
+    const int b = (int)std::lround(std::min(std::max(c[2], 0.0f), 255.0f) * 31.0f / 255.0f);
+    return (uint16_t)((r << 11) | (g << 5) | b);
+}
+
+inline void Unpack565(uint16_t v, int out[3]) {
+    const int r = (v >> 11) & 31, g = (v >> 5) & 63, b = v & 31;
+    out[0] = (r << 3) | (r >> 2);
+    out[1] = (g << 2) | (g >> 4);
+    out[2] = (b << 3) | (b >> 2);
+}
+
+// --- Blok koloru DXT1 (8 bajtów), zawsze w trybie 4 kolorów ---
+inline void EncodeColorBlockDXT1(const unsigned char block[16][4], unsigned char* out) {
+    // Średnia i kowariancja; oś główna z kilku iteracji metody potęgowej
+    float mean[3] = {0, 0, 0};
+    for (int i = 0; i < 16; ++i)
+        for (int c = 0; c < 3; ++c) mean[c] += block[i][c];
+    for (int c = 0; c < 3; ++c) mean[c] /= 16.0f;
+
+    float cov[6] = {0, 0, 0, 0, 0, 0}; // rr rg rb gg gb bb
+    for (int i = 0; i < 16; ++i) {
+        const float r = block[i][0] - mean[0], g = block[i][1] - mean[1], b = block[i][2] - mean[2];
+        cov[0] += r * r; cov[1] += r * g; cov[2] += r * b;
+        cov[3] += g * g; cov[4] += g * b; cov[5] += b * b;
+    }
+    float axis[3] = {1, 1, 1};
+    for (int it = 0; it < 4; ++it) {
+        const float x = cov[0] * axis[0] + cov[1] * axis[1] + cov[2] * axis[2];
+        const float y = cov[1] * axis[0] + cov[3] * axis[1] + cov[4] * axis[2];
+        const float z = cov[2] * axis[0] + cov[4] * axis[1] + cov[5] * axis[2];
+        const float len = std::max(std::fabs(x), std::max(std::fabs(y), std::fabs(z)));
+        if (len < 1e-6f) break;
+        axis[0] = x / len; axis[1] = y / len; axis[2] = z / len;
+    }
+
+    // Skrajne rzuty na oś jako końce odcinka
+    float minT = 1e30f, maxT = -1e30f;
+    for (int i = 0; i < 16; ++i) {
+        const float t = (block[i][0] - mean[0]) * axis[0] + (block[i][1] - mean[1]) * axis[1] + (block[i][2] - mean[2]) * axis[2];
+        minT = std::min(minT, t);
+        maxT = std::max(maxT, t);
+    }
+    const float norm = axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2];
+    float endMax[3], endMin[3];
+    for (int c = 0; c < 3; ++c) {
+        endMax[c] = mean[c] + axis[c] * maxT / std::max(norm, 1e-6f);
+        endMin[c] = mean[c] + axis[c] * minT / std::max(norm, 1e-6f);
+    }
+    uint16_t c0 = Pack565(endMax), c1 = Pack565(endMin);
+    if (c0 < c1) std::swap(c0, c1);
+
+    uint32_t indices = 0;
+    if (c0 != c1) {
+        int palette[4][3];
+        Unpack565(c0, palette[0]);
+        Unpack565(c1, palette[1]);
+        for (int c = 0; c < 3; ++c) {
+            palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+            palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+        }
+        for (int i = 0; i < 16; ++i) {
+            int best = 0, bestErr = 1 << 30;
+            for (int p = 0; p < 4; ++p) {
+                const int dr = block[i][0] - palette[p][0], dg = block[i][1] - palette[p][1], db = block[i][2] - palette[p][2];
+                const int err = dr * dr + dg * dg + db * db;
+                if (err < bestErr) { bestErr = err; best = p; }
+            }
+            indices |= (uint32_t)best << (2 * i);
+        }
+    } // c0 == c1: wszystkie indeksy 0 (indeks 3 w trybie 3 kolorów byłby przezroczysty)
+
+    out[0] = (unsigned char)(c0 & 0xFF); out[1] = (unsigned char)(c0 >> 8);
+    out[2] = (unsigned char)(c1 & 0xFF); out[3] = (unsigned char)(c1 >> 8);
+    for (int b = 0; b < 4; ++b) out[4 + b] = (unsigned char)(indices >> (8 * b));
+}
+
+// --- Blok alfa DXT5 (8 bajtów): a0 > a1, 8 poziomów interpolowanych ---
+inline void EncodeAlphaBlockDXT5(const unsigned char block[16][4], unsigned char* out) {
+    int a0 = 0, a1 = 255;
+    for (int i = 0; i < 16; ++i) {
+        a0 = std::max(a0, (int)block[i][3]);
+        a1 = std::min(a1, (int)block[i][3]);
+    }
+    uint64_t indices = 0;
+    if (a0 != a1) {
+        int palette[8] = {a0, a1};
+        for (int k = 2; k < 8; ++k) palette[k] = ((8 - k) * a0 + (k - 1) * a1) / 7;
+        for (int i = 0; i < 16; ++i) {
+            int best = 0, bestErr = 256;
+            for (int p = 0; p < 8; ++p) {
+                const int err = std::abs(block[i][3] - palette[p]);
+                if (err < bestErr) { bestErr = err; best = p; }
+            }
+            indices |= (uint64_t)best << (3 * i);
+        }
+    }
+    out[0] = (unsigned char)a0;
+    out[1] = (unsigned char)a1;
+    for (int b = 0; b < 6; ++b) out[2 + b] = (unsigned char)(indices >> (8 * b));
+}
+
+// Tablice modyfikatorów ETC1 (mały, duży); indeksy pikseli: 0 = +mały, 1 = +duży, 2 = -mały, 3 = -duży
+static const int kEtc1Modifiers[8][2] = {{2, 8}, {5, 17}, {9, 29}, {13, 42}, {18, 60}, {24, 80}, {33, 106}, {47, 183}};
+
+// Najlepsza tablica dla 8 pikseli podbloku przy danym kolorze bazowym; zwraca błąd
+inline int FitEtc1Subblock(const unsigned char block[16][4], const int pixels[8], const int base[3],
+                           int& table, int selectors[8]) {
+    int bestErr = 1 << 30;
+    for (int t = 0; t < 8; ++t) {
+        const int mods[4] = {kEtc1Modifiers[t][0], kEtc1Modifiers[t][1], -kEtc1Modifiers[t][0], -kEtc1Modifiers[t][1]};
+        int err = 0, chosen[8];
+        for (int i = 0; i < 8 && err < bestErr; ++i) {
+            const unsigned char* px = block[pixels[i]];
+            int pixelBest = 1 << 30;
+            for (int m = 0; m < 4; ++m) {
+                const int dr = px[0] - Clamp255(base[0] + mods[m]);
+                const int dg = px[1] - Clamp255(base[1] + mods[m]);
+                const int db = px[2] - Clamp255(base[2] + mods[m]);
+                const int e = dr * dr + dg * dg + db * db;
+                if (e < pixelBest) { pixelBest = e; chosen[i] = m; }
+            }
+            err += pixelBest;
+        }
+        if (err < bestErr) {
+            bestErr = err;
+            table = t;
+            std::memcpy(selectors, chosen, sizeof(chosen));
+        }
+    }
+    return bestErr;
+}
+
+// --- Blok ETC1 (8 bajtów): oba podziały (2x4 / 4x2), tryb indywidualny 444 albo różnicowy 555 ---
+inline void EncodeBlockETC1(const unsigned char block[16][4], unsigned char* out) {
+    int bestErr = 1 << 30;
+    for (int flip = 0; flip < 2; ++flip) {
+        // Piksele podbloków w kolejności ETC1: indeks piksela = x * 4 + y
+        int pixels[2][8], pixelIndex[2][8];
+        int count[2] = {0, 0};
+        for (int x = 0; x < 4; ++x) {
+            for (int y = 0; y < 4; ++y) {
+                const int sub = flip ? (y >= 2) : (x >= 2);
+                pixels[sub][count[sub]] = y * 4 + x;
+                pixelIndex[sub][count[sub]++] = x * 4 + y;
+            }
+        }
+
+        float avg[2][3];
+        for (int s = 0; s < 2; ++s) {
+            for (int c = 0; c < 3; ++c) {
+                int sum = 0;
+                for (int i = 0; i < 8; ++i) sum += block[pixels[s][i]][c];
+                avg[s][c] = sum / 8.0f;
+            }
+        }
+
+        for (int diff = 0; diff < 2; ++diff) {
+            int quant[2][3], base[2][3];
+            bool valid = true;
+            for (int s = 0; s < 2; ++s) {
+                for (int c = 0; c < 3; ++c) {
+                    if (diff) {
+                        quant[s][c] = (int)std::lround(avg[s][c] * 31.0f / 255.0f);
+                        base[s][c] = (quant[s][c] << 3) | (quant[s][c] >> 2);
+                    } else {
+                        quant[s][c] = (int)std::lround(avg[s][c] * 15.0f / 255.0f);
+                        base[s][c] = (quant[s][c] << 4) | quant[s][c];
+                    }
+                }
+            }
+            int delta[3] = {0, 0, 0};
+            if (diff) {
+                for (int c = 0; c < 3; ++c) {
+                    delta[c] = quant[1][c] - quant[0][c];
+                    valid = valid && delta[c] >= -4 && delta[c] <= 3;
+                }
+            }
+            if (!valid) continue;
+
+            int table[2] = {0, 0}, selectors[2][8];
+            const int err = FitEtc1Subblock(block, pixels[0], base[0], table[0], selectors[0]) +
+                            FitEtc1Subblock(block, pixels[1], base[1], table[1], selectors[1]);
+            if (err >= bestErr) continue;
+            bestErr = err;
+
+            for (int c = 0; c < 3; ++c) {
+                out[c] = diff ? (unsigned char)((quant[0][c] << 3) | (delta[c] & 7))
+                              : (unsigned char)((quant[0][c] << 4) | quant[1][c]);
+            }
+            out[3] = (unsigned char)((table[0] << 5) | (table[1] << 2) | (diff << 1) | flip);
+            uint32_t msb = 0, lsb = 0;
+            for (int s = 0; s < 2; ++s) {
+                for (int i = 0; i < 8; ++i) {
+                    msb |= (uint32_t)(selectors[s][i] >> 1) << pixelIndex[s][i];
+                    lsb |= (uint32_t)(selectors[s][i] & 1) << pixelIndex[s][i];
+                }
+            }
+            const uint32_t bits = (msb << 16) | lsb; // Big-endian, jak cały blok ETC1
+            out[4] = (unsigned char)(bits >> 24); out[5] = (unsigned char)(bits >> 16);
+            out[6] = (unsigned char)(bits >> 8); out[7] = (unsigned char)bits;
+        }
+    }
+}
+
+}  // namespace texcomp_detail
+
+inline size_t CompressedLevelSize(GLenum format, int width, int height) {
+    const size_t blocks = (size_t)((width + 3) / 4) * ((height + 3) / 4);
+    return blocks * (format == GL_COMPRESSED_RGBA_S3TC_DXT5_EXT ? 16 : 8);
+}
+
+// --- Kodowanie jednego poziomu w wybranym formacie ---
+inline CompressedLevel EncodeCompressedLevel(const MipLevel& level, int components, GLenum format) {
+    CompressedLevel out;
+    out.width = level.width;
+    out.height = level.height;
+    out.data.resize(CompressedLevelSize(format, level.width, level.height));
+
+    const int blocksX = (level.width + 3) / 4, blocksY = (level.height + 3) / 4;
+    unsigned char* dst = out.data.data();
+    unsigned char block[16][4];
+    for (int by = 0; by < blocksY; ++by) {
+        for (int bx = 0; bx < blocksX; ++bx) {
+            texcomp_detail::FetchBlock(level, components, bx, by, block);
+            if (format == GL_ETC1_RGB8_OES) {
+                texcomp_detail::EncodeBlockETC1(block, dst);
+                dst += 8;
+            } else if (format == GL_COMPRESSED_RGBA_S3TC_DXT5_EXT) {
+                texcomp_detail::EncodeAlphaBlockDXT5(block, dst);
+                texcomp_detail::EncodeColorBlockDXT1(block, dst + 8);
+                dst += 16;
+            } else {
+                texcomp_detail::EncodeColorBlockDXT1(block, dst);
+                dst += 8;
+            }
+        }
+    }
+    return out;
+}
+
+inline bool HasTranslucentPixels(const MipLevel& level, int components) {
+    if (components != 4) return false;
+    for (size_t i = 3; i < level.pixels.size(); i += 4) {
+        if (level.pixels[i] != 255) return true;
+    }
+    return false;
+}
+
+// --- Kodowanie obrazu z łańcuchem mipmap (tylko POT, jak w texture_mipmaps.h) ---
+// Zwraca false, gdy obraz nie pasuje do formatu: ETC1 nie ma alfy, a S3TC w WebGL
+// wymaga poziomu 0 o wymiarach podzielnych przez 4.
+inline bool EncodeCompressedTexture(const MipLevel& base, int components, CompressedFamily family,
+                                    CompressedTexture& out) {
+    if (base.width % 4 != 0 || base.height % 4 != 0) return false;
+    if (components != 1 && components != 3 && components != 4) return false;
+    const bool alpha = HasTranslucentPixels(base, components);
+    if (family == CompressedFamily::ETC1 && alpha) return false;
+
+    out.format = family == CompressedFamily::ETC1 ? GL_ETC1_RGB8_OES
+                 : alpha                          ? GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+                                                  : GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+    out.levels.clear();
+    out.levels.push_back(EncodeCompressedLevel(base, components, out.format));
+    if (!IsPowerOfTwo(base.width) || !IsPowerOfTwo(base.height)) return true;
+
+    MipLevel level;
+    for (const MipLevel* src = &base; src->width > 1 || src->height > 1; src = &level) {
+        level = DownsampleBox(*src, components);
+        out.levels.push_back(EncodeCompressedLevel(level, components, out.format));
+    }
+    return true;
+}
+
+// --- Pamięć podręczna: plik "<hash>.<rodzina>.ctex" w textureCacheDir ---
+// Format: "GLBCTEX1", uint32 format GL, uint32 liczba poziomów, potem dla każdego poziomu
+// uint32 szerokość, wysokość, rozmiar i dane (little-endian, jak x86 i wasm).
+static const char kCompressedMagic[8] = {'G', 'L', 'B', 'C', 'T', 'E', 'X', '1'};
+
+// Katalog pamięci podręcznej. W przeglądarce nie jest w --preload-file (cały katalog trafiłby do .data
+// i MEMFS) - leży obok index.html, a plik rodziny obsługiwanej przez GPU jest pobierany na żądanie.
+inline std::string textureCacheDir = "asserts/texture_cache";
+// Szukanie skompresowanych wersji tekstur przy ładowaniu (wyłączone = zawsze RGBA8)
+inline bool compressTextures = true;
+
+// FNV-1a 64 bajtów obrazu tak jak są zapisane w GLB (PNG/JPEG) - bez dekodowania
+inline uint64_t HashImageBytes(const unsigned char* data, size_t size) {
+    uint64_t hash = 1469598103934665603ull;
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= data[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+inline const char* CompressedFamilyName(CompressedFamily family) {
+    return family == CompressedFamily::ETC1 ? "etc1" : "s3tc";
+}
+
+inline std::string CompressedCachePath(uint64_t hash, CompressedFamily family) {
+    char name[40];
+    std::snprintf(name, sizeof(name), "%016llx.%s.ctex", (unsigned long long)hash, CompressedFamilyName(family));
+    return textureCacheDir + "/" + name;
+}
+
+inline bool WriteCompressedTexture(const std::string& path, const CompressedTexture& texture) {
+    FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) return false;
+    bool ok = std::fwrite(kCompressedMagic, 1, 8, file) == 8;
+    const uint32_t header[2] = {(uint32_t)texture.format, (uint32_t)texture.levels.size()};
+    ok = ok && std::fwrite(header, sizeof(header), 1, file) == 1;
+    for (const CompressedLevel& level : texture.levels) {
+        const uint32_t info[3] = {(uint32_t)level.width, (uint32_t)level.height, (uint32_t)level.data.size()};
+        ok = ok && std::fwrite(info, sizeof(info), 1, file) == 1;
+        ok = ok && std::fwrite(level.data.data(), 1, level.data.size(), file) == level.data.size();
+    }
+    return std::fclose(file) == 0 && ok;
+}
+
+// Wspólny parser dla pliku i bufora w pamięci; `read(dst, n)` = false, gdy brakuje danych
+template <typename Read>
+inline bool ReadCompressedTextureFrom(Read read, CompressedTexture& texture) {
+    char magic[8];
+    uint32_t header[2];
+    bool ok = read(magic, 8) && std::memcmp(magic, kCompressedMagic, 8) == 0 && read(header, sizeof(header)) &&
+              header[1] > 0 && header[1] <= 16;
+    texture.format = ok ? header[0] : 0;
+    texture.levels.assign(ok ? header[1] : 0, CompressedLevel());
+    for (CompressedLevel& level : texture.levels) {
+        uint32_t info[3];
+        ok = ok && read(info, sizeof(info)) && info[0] > 0 && info[1] > 0 &&
+             info[2] == CompressedLevelSize(texture.format, (int)info[0], (int)info[1]);
+        if (!ok) break;
+        level.width = (int)info[0];
+        level.height = (int)info[1];
+        level.data.resize(info[2]);
+        ok = read(level.data.data(), level.data.size());
+    }
+    return ok;
+}
+
+inline bool ReadCompressedTexture(const std::string& path, CompressedTexture& texture) {
+    FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) return false;
+    const bool ok = ReadCompressedTextureFrom(
+        [file](void* dst, size_t size) { return std::fread(dst, 1, size, file) == size; }, texture);
+    std::fclose(file);
+    return ok;
+}
+
+// Plik .ctex pobrany do pamięci (przeglądarka - emscripten_async_wget_data)
+inline bool ParseCompressedTexture(const unsigned char* data, size_t size, CompressedTexture& texture) {
+    size_t offset = 0;
+    return ReadCompressedTextureFrom(
+        [&](void* dst, size_t bytes) {
+            if (bytes > size - offset) return false;
+            std::memcpy(dst, data + offset, bytes);
+            offset += bytes;
+            return true;
+        },
+        texture);
+}
+
+// --- Czy GPU przyjmie dany format (rozszerzenia z LoadGLExtensions) ---
+inline bool CompressedFamilySupported(CompressedFamily family) {
+    return family == CompressedFamily::ETC1 ? glExt.textureETC1 : glExt.textureS3TC;
+}
+
+inline size_t CompressedTextureBytes(const CompressedTexture& texture) {
+    size_t bytes = 0;
+    for (const CompressedLevel& level : texture.levels) bytes += level.data.size();
+    return bytes;
+}
+
+// --- Upload wszystkich poziomów; pełny łańcuch od razu z GL_LINEAR_MIPMAP_LINEAR ---
+inline GLuint UploadCompressedTexture(const CompressedTexture& texture) {
+    while (glGetError() != GL_NO_ERROR) {
+    } // Błędy sprzed uploadu nie dotyczą tej tekstury
+    GLuint tex;
+    glGenTextures(1, &tex);
+    glState.BindTexture(GL_TEXTURE_2D, tex);
+    for (size_t i = 0; i < texture.levels.size(); ++i) {
+        const CompressedLevel& level = texture.levels[i];
+        glCompressedTexImage2D(GL_TEXTURE_2D, (GLint)i, texture.format, level.width, level.height, 0,
+                               (GLsizei)level.data.size(), level.data.data());
+    }
+    if (glGetError() != GL_NO_ERROR) {
+        glState.BindTexture(GL_TEXTURE_2D, 0); // ID wróci do puli - cache nie może go pamiętać
+        glDeleteTextures(1, &tex);
+        return 0;
+    }
+    const CompressedLevel& last = texture.levels.back();
+    const bool fullChain = texture.levels.size() > 1 && last.width == 1 && last.height == 1;
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, fullChain ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    return tex;
+}
+
+#endif  // TEXTURE_COMPRESSION_H_
@@ -0,0 +1,332 @@
+// Mipmapy liczone na CPU poza wątkiem renderowania (filtr pudełkowy 2x2, SSE2 /
+// WASM SIMD128 dla RGBA) i wgrywane na GPU po kilka poziomów na klatkę. Zlecenia
+// trafiają do wspólnej kolejki, z której biorą je wątki robocze (najwyżej tyle,
+// ile rdzeni) - tak jak przy równoległym dekodowaniu obrazów.
+// Do czasu wgrania całego łańcucha tekstura jest próbkowana z GL_LINEAR (GLES2 nie
+// ma GL_TEXTURE_MAX_LEVEL, więc niepełny łańcuch z filtrem mipmap byłby niekompletny),
+// potem przełączamy na GL_LINEAR_MIPMAP_LINEAR.
+//
+// GLES2 / WebGL1 nie pozwalają na mipmapy tekstur NPOT - takie zostają z GL_LINEAR.
+// W Emscripten bez -pthread nie ma wątków: poziomy są liczone w PumpMipmapUploads
+// po kMipmapSliceRows wierszy, najwyżej mipmapBuildBudgetMs na klatkę.
+#ifndef TEXTURE_MIPMAPS_H_
+#define TEXTURE_MIPMAPS_H_
+
+#include <GLES2/gl2.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "gl_state.h"
+#include "load_profiler.h"
+
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+#define MIPMAPS_NO_THREADS 1
+#else
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define MIPMAPS_SSE2 1
+#elif defined(__wasm_simd128__)
+#include <wasm_simd128.h>
+#define MIPMAPS_WASM_SIMD 1
+#endif
+
+struct MipLevel {
+    int width = 0;
+    int height = 0;
+    std::vector<unsigned char> pixels;
+};
+
+namespace mipmap_detail {
+
+// Dwa wyjściowe piksele RGBA z 4 pikseli dwóch wierszy: (a + b + c + d + 2) / 4
+inline void DownsampleRowRGBA(const unsigned char* row0, const unsigned char* row1, unsigned char* dst, int dstWidth) {
+    int x = 0;
+#if defined(MIPMAPS_SSE2)
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i two = _mm_set1_epi16(2);
+    for (; x + 2 <= dstWidth; x += 2) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row0 + x * 8));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row1 + x * 8));
+        __m128i lo = _mm_add_epi16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero)); // piksele 0, 1
+        __m128i hi = _mm_add_epi16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero)); // piksele 2, 3
+        lo = _mm_add_epi16(lo, _mm_srli_si128(lo, 8));
+        hi = _mm_add_epi16(hi, _mm_srli_si128(hi, 8));
+        __m128i sum = _mm_srli_epi16(_mm_add_epi16(_mm_unpacklo_epi64(lo, hi), two), 2);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + x * 4), _mm_packus_epi16(sum, sum));
+    }
+#elif defined(MIPMAPS_WASM_SIMD)
+    const v128_t two = wasm_i16x8_splat(2);
+    for (; x + 2 <= dstWidth; x += 2) {
+        v128_t a = wasm_v128_load(row0 + x * 8);
+        v128_t b = wasm_v128_load(row1 + x * 8);
+        v128_t lo = wasm_i16x8_add(wasm_u16x8_extend_low_u8x16(a), wasm_u16x8_extend_low_u8x16(b));
+        v128_t hi = wasm_i16x8_add(wasm_u16x8_extend_high_u8x16(a), wasm_u16x8_extend_high_u8x16(b));
+        lo = wasm_i16x8_add(lo, wasm_i64x2_shuffle(lo, lo, 1, 1));
+        hi = wasm_i16x8_add(hi, wasm_i64x2_shuffle(hi, hi, 1, 1));
+        v128_t sum = wasm_u16x8_shr(wasm_i16x8_add(wasm_i64x2_shuffle(lo, hi, 0, 2), two), 2);
+        wasm_v128_store64_lane(dst + x * 4, wasm_u8x16_narrow_i16x8(sum, sum), 0);
+    }
+#endif
+    for (; x < dstWidth; ++x) {
+        for (int c = 0; c < 4; ++c) {
+            dst[x * 4 + c] = (unsigned char)((row0[x * 8 + c] + row0[x * 8 + 4 + c] + row1[x * 8 + c] + row1[x * 8 + 4 + c] + 2) >> 2);
+        }
+    }
+}
+
+}  // namespace mipmap_detail
+
+// --- Pusty następny poziom mipmapy (połowa rozmiaru, min. 1) ---
+// Pamięć jest tylko rezerwowana - DownsampleBoxRows dokłada wiersze, więc zerowanie dużego
+// poziomu nie wypada w całości na pierwszy kawałek.
+inline MipLevel NextMipLevel(const MipLevel& src, int components) {
+    MipLevel dst;
+    dst.width = std::max(1, src.width / 2);
+    dst.height = std::max(1, src.height / 2);
+    dst.pixels.reserve((size_t)dst.width * dst.height * components);
+    return dst;
+}
+
+// --- Wiersze [firstRow, endRow) poziomu dst z poziomu src; wiersze liczone po kolei ---
+// Krawędź o długości 1 jest powielana - tak powstają poziomy 2x1, 1x2 itd.
+inline void DownsampleBoxRows(const MipLevel& src, MipLevel& dst, int components, int firstRow, int endRow) {
+    const size_t srcStride = (size_t)src.width * components;
+    const size_t dstStride = (size_t)dst.width * components;
+    dst.pixels.resize(std::max(dst.pixels.size(), endRow * dstStride));
+    const bool fullQuads = (src.width == dst.width * 2) && (src.height == dst.height * 2);
+
+    for (int y = firstRow; y < endRow; ++y) {
+        const unsigned char* row0 = src.pixels.data() + std::min(2 * y, src.height - 1) * srcStride;
+        const unsigned char* row1 = src.pixels.data() + std::min(2 * y + 1, src.height - 1) * srcStride;
+        unsigned char* out = dst.pixels.data() + y * dstStride;
+        if (fullQuads && components == 4) {
+            mipmap_detail::DownsampleRowRGBA(row0, row1, out, dst.width);
+            continue;
+        }
+        for (int x = 0; x < dst.width; ++x) {
+            const int x0 = std::min(2 * x, src.width - 1) * components;
+            const int x1 = std::min(2 * x + 1, src.width - 1) * components;
+            for (int c = 0; c < components; ++c) {
+                out[x * components + c] = (unsigned char)((row0[x0 + c] + row0[x1 + c] + row1[x0 + c] + row1[x1 + c] + 2) >> 2);
+            }
+        }
+    }
+}
+
+// --- Następny poziom mipmapy w całości ---
+inline MipLevel DownsampleBox(const MipLevel& src, int components) {
+    MipLevel dst = NextMipLevel(src, components);
+    DownsampleBoxRows(src, dst, components, 0, dst.height);
+    return dst;
+}
+
+// Łańcuch mipmap jednej tekstury: wątek roboczy liczy poziomy 1..N, wątek GL je wgrywa
+struct MipmapJob {
+    GLuint texture = 0;
+    GLenum format = GL_RGBA;
+    int components = 4;
+    MipLevel base;               // Poziom 0 (już na GPU); zwalniany po policzeniu poziomu 1
+    std::vector<MipLevel> levels; // levels[i] = poziom i + 1; rozmiar stały od początku (bez realokacji)
+    std::atomic<int> ready{0};    // Ile poziomów z levels jest gotowych (zapis: wątek roboczy)
+    std::atomic<bool> cancel{false};
+    std::atomic<bool> finished{false}; // Wątek roboczy już nie dotyka zlecenia
+    int uploaded = 0;             // Ile poziomów z levels jest już na GPU (tylko wątek GL)
+    int row = 0;                  // Następny wiersz levels[ready] (poziom liczony w kawałkach)
+
+    // Liczy do `rows` kolejnych wierszy levels[ready]; ukończony poziom jest publikowany przez ready.
+    // Zwraca false, gdy łańcuch jest kompletny.
+    bool BuildRows(int rows) {
+        const int next = ready.load(std::memory_order_relaxed);
+        if (next >= (int)levels.size()) return false;
+        const MipLevel& src = (next == 0) ? base : levels[next - 1];
+        MipLevel& dst = levels[next];
+        LOAD_PROFILE_SCOPE("DownsampleBox (mipmapa)");
+        if (row == 0) dst = NextMipLevel(src, components);
+        const int end = (rows >= dst.height - row) ? dst.height : row + rows;
+        DownsampleBoxRows(src, dst, components, row, end);
+        row = end;
+        if (row < dst.height) return true;
+        row = 0;
+        if (next == 0) MipLevel().pixels.swap(base.pixels);
+        ready.store(next + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Liczy cały levels[ready]; zwraca false, gdy łańcuch jest kompletny
+    bool BuildNext() { return BuildRows(INT_MAX); }
+};
+
+#ifndef MIPMAPS_NO_THREADS
+// Kolejka zleceń i pula wątków tworzonych w miarę potrzeb, najwyżej hardware_concurrency().
+// Wątek bierze zlecenie z kolejki i liczy cały jego łańcuch (albo do anulowania).
+class MipmapWorkers {
+public:
+    ~MipmapWorkers() { Stop(); }
+
+    void Push(MipmapJob* job) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            queue_.push_back(job);
+            stop_ = false;
+        }
+        if (threads_.size() < std::max(1u, std::thread::hardware_concurrency())) {
+            threads_.emplace_back(&MipmapWorkers::Run, this);
+        }
+        wake_.notify_one();
+    }
+
+    // Czyści kolejkę, czeka na dokończenie bieżących zleceń (anulowane kończą się po poziomie) i kończy wątki
+    void Stop() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+            queue_.clear();
+        }
+        wake_.notify_all();
+        for (auto& thread : threads_) thread.join();
+        threads_.clear();
+    }
+
+private:
+    void Run() {
+        for (;;) {
+            MipmapJob* job;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                wake_.wait(lock, [this]() { return stop_ || !queue_.empty(); });
+                if (stop_) return;
+                job = queue_.front();
+                queue_.pop_front();
+            }
+            while (!job->cancel.load(std::memory_order_relaxed) && job->BuildNext()) {
+            }
+            job->finished.store(true, std::memory_order_release);
+        }
+    }
+
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::deque<MipmapJob*> queue_;
+    std::vector<std::thread> threads_; // Tylko wątek GL
+    bool stop_ = false;
+};
+#endif
+
+// Mipmapy dla tekstur ładowanych z modelu (wyłączone = tylko GL_LINEAR, jak wcześniej)
+inline bool generateMipmaps = true;
+// Ile bajtów poziomów wgrywać na klatkę (co najmniej jeden poziom)
+inline size_t mipmapUploadBudget = 4u << 20;
+// Bez wątków: ile ms na klatkę liczyć poziomy w PumpMipmapUploads (co najmniej jeden kawałek)
+inline double mipmapBuildBudgetMs = 2.0;
+inline const int kMipmapSliceRows = 16;
+inline std::vector<std::unique_ptr<MipmapJob>> mipmapJobs;
+#ifndef MIPMAPS_NO_THREADS
+inline MipmapWorkers mipmapWorkers; // Po mipmapJobs - niszczone wcześniej, wątki kończą przed zleceniami
+#endif
+
+inline bool IsPowerOfTwo(int v) { return v > 0 && (v & (v - 1)) == 0; }
+
+// --- Zlecenie mipmap dla tekstury z wgranym poziomem 0; pixels są przejmowane ---
+// Zwraca false dla tekstur, które w GLES2 nie mogą mieć mipmap (NPOT) lub mają nietypowy format.
+inline bool QueueMipmaps(GLuint texture, GLenum format, int components, int width, int height,
+                         std::vector<unsigned char>&& pixels) {
+    if (!generateMipmaps || !IsPowerOfTwo(width) || !IsPowerOfTwo(height)) return false;
+    if (components != 1 && components != 3 && components != 4) return false;
+    if (pixels.size() < (size_t)width * height * components || (width == 1 && height == 1)) return false;
+
+    std::unique_ptr<MipmapJob> job(new MipmapJob());
+    job->texture = texture;
+    job->format = format;
+    job->components = components;
+    job->base.width = width;
+    job->base.height = height;
+    job->base.pixels = std::move(pixels);
+
+    int levelCount = 0;
+    for (int w = width, h = height; w > 1 || h > 1; w = std::max(1, w / 2), h = std::max(1, h / 2)) ++levelCount;
+    job->levels.resize(levelCount);
+
+#ifndef MIPMAPS_NO_THREADS
+    mipmapWorkers.Push(job.get());
+#endif
+    mipmapJobs.push_back(std::move(job));
+    return true;
+}
+
+inline bool MipmapsPending() { return !mipmapJobs.empty(); }
+
+// --- Wywoływane raz na klatkę przed rysowaniem: wgranie gotowych poziomów ---
+// Zmienia zbindowaną teksturę na jednostce 0 (przez glState).
+inline void PumpMipmapUploads() {
+    if (mipmapJobs.empty()) return;
+
+    size_t budget = mipmapUploadBudget;
+    bool uploadedAny = false;
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1); // Wiersze RGB / małych poziomów nie są wyrównane do 4
+
+#ifdef MIPMAPS_NO_THREADS
+    // Kawałki po kMipmapSliceRows wierszy - duży poziom rozkłada się na kilka klatek
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::microseconds((long long)(mipmapBuildBudgetMs * 1000));
+    for (auto& job : mipmapJobs) {
+        bool timeLeft = true;
+        while (timeLeft && job->BuildRows(kMipmapSliceRows)) timeLeft = std::chrono::steady_clock::now() < deadline;
+        if (!timeLeft) break;
+    }
+#endif
+
+    for (auto it = mipmapJobs.begin(); it != mipmapJobs.end();) {
+        MipmapJob& job = **it;
+        const int ready = job.ready.load(std::memory_order_acquire);
+        while (job.uploaded < ready && (!uploadedAny || budget > 0)) {
+            MipLevel& level = job.levels[job.uploaded];
+            LOAD_PROFILE_SCOPE("PumpMipmapUploads (glTexImage2D)");
+            glState.ActiveTexture(GL_TEXTURE0);
+            glState.BindTexture(GL_TEXTURE_2D, job.texture);
+            glTexImage2D(GL_TEXTURE_2D, job.uploaded + 1, job.format, level.width, level.height, 0,
+                         job.format, GL_UNSIGNED_BYTE, level.pixels.data());
+            budget -= std::min(budget, level.pixels.size());
+            uploadedAny = true;
+            ++job.uploaded;
+        }
+
+#ifdef MIPMAPS_NO_THREADS
+        const bool done = job.uploaded == (int)job.levels.size();
+#else
+        const bool done = job.uploaded == (int)job.levels.size() && job.finished.load(std::memory_order_acquire);
+#endif
+        if (done) {
+            // Łańcuch kompletny - dopiero teraz filtr z mipmapami
+            glState.ActiveTexture(GL_TEXTURE0);
+            glState.BindTexture(GL_TEXTURE_2D, job.texture);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+            it = mipmapJobs.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+}
+
+// --- Przerwanie wszystkich zleceń (przed usunięciem tekstur) ---
+inline void CancelMipmapJobs() {
+    for (auto& job : mipmapJobs) job->cancel.store(true);
+#ifndef MIPMAPS_NO_THREADS
+    mipmapWorkers.Stop(); // Join - żaden wątek nie odwołuje się już do zleceń
+#endif
+    mipmapJobs.clear();
+}
+
+#endif  // TEXTURE_MIPMAPS_H_
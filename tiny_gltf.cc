@@ -1,4 +1,7 @@
 #define TINYGLTF_IMPLEMENTATION
 #define STB_IMAGE_IMPLEMENTATION
 #define STB_IMAGE_WRITE_IMPLEMENTATION
+// Etapy ładowania tinygltf w profilu load_profiler.h
+#include "load_profiler.h"
+#define TINYGLTF_PROFILE_SCOPE(name) LOAD_PROFILE_SCOPE(name)
 #include "tiny_gltf.h"
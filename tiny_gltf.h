@@ -46,6 +46,7 @@
 #include <functional>
 #include <limits>
 #include <map>
+#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
@@ -1024,6 +1025,38 @@ class Node {
   std::string extensions_json_string;
 };
 
+///
+/// Read-only view of a whole file mapped into memory.
+/// Buffers loaded with `TinyGLTF::SetMemoryMapBinary(true)` share ownership
+/// of the mapping, so it is released together with the last `Buffer`
+/// (usually: the `Model`) referencing it.
+///
+class MappedFile {
+ public:
+  ~MappedFile();
+
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  const unsigned char *data() const { return data_; }
+  size_t size() const { return size_; }
+
+  ///
+  /// Maps `filepath` read-only. Falls back to reading the file into memory
+  /// on platforms without mmap. Returns nullptr and sets `err` on failure.
+  ///
+  static std::shared_ptr<MappedFile> Open(const std::string &filepath,
+                                          std::string *err);
+
+ private:
+  MappedFile() = default;
+
+  const unsigned char *data_{nullptr};
+  size_t size_{0};
+  bool mapped_{false};
+  std::vector<unsigned char> fallback_;  // Used when mmap is not available.
+};
+
 struct Buffer {
   std::string name;
   std::vector<unsigned char> data;
@@ -1037,6 +1070,19 @@ struct Buffer {
   std::string extras_json_string;
   std::string extensions_json_string;
 
+  // Zero-copy GLB BIN chunk(see `TinyGLTF::SetMemoryMapBinary`). When
+  // `mapping` is set, `data` is empty and the bytes are
+  // [mapped_data, mapped_data + mapped_size) inside the mapping.
+  // Use `DataPtr()`/`DataSize()` to read the buffer regardless of storage.
+  std::shared_ptr<const MappedFile> mapping;
+  const unsigned char *mapped_data{nullptr};
+  size_t mapped_size{0};
+
+  const unsigned char *DataPtr() const {
+    return mapping ? mapped_data : data.data();
+  }
+  size_t DataSize() const { return mapping ? mapped_size : data.size(); }
+
   Buffer() = default;
   DEFAULT_METHODS(Buffer)
   bool operator==(const Buffer &) const;
@@ -1375,6 +1421,18 @@ using WriteImageDataFunction = std::function<bool(
 bool LoadImageData(Image *image, const int image_idx, std::string *err,
                    std::string *warn, int req_width, int req_height,
                    const unsigned char *bytes, int size, void *);
+
+///
+/// Decode an image loaded with `TinyGLTF::SetImagesAsIs(true)` on demand.
+/// `encoded.image` holds the file bytes(PNG, JPEG, ...); the decoded pixels
+/// are stored to `decoded`, `encoded` is left untouched so the caller
+/// decides when to release either copy. Channels are expanded to RGBA
+/// unless `preserve_channels` is true. Images that are not `as_is` are
+/// copied as they are.
+///
+bool DecodeImageAsIs(const Image &encoded, Image *decoded, int image_idx,
+                     std::string *err, std::string *warn,
+                     bool preserve_channels = false);
 #endif
 
 #ifndef TINYGLTF_NO_STB_IMAGE_WRITE
@@ -1543,6 +1601,32 @@ class TinyGLTF {
 
   bool GetImagesAsIs() const { return images_as_is_; }
 
+  ///
+  /// Specify whether `LoadBinaryFromFile` maps the GLB file into memory
+  /// instead of reading it(default = false). When enabled, the embedded BIN
+  /// chunk is not copied: `Buffer::mapping` keeps the mapping alive and
+  /// `Buffer::DataPtr()` points straight into it.
+  ///
+  void SetMemoryMapBinary(bool onoff) { memory_map_binary_ = onoff; }
+
+  bool GetMemoryMapBinary() const { return memory_map_binary_; }
+
+  ///
+  /// Set the number of threads used to decode images(default = 1: decode
+  /// serially while parsing). 0 = std::thread::hardware_concurrency().
+  /// With more than one thread, images are decoded after the `images` array
+  /// is parsed, each worker decoding one image at a time, so at most
+  /// `num_threads` images are being decoded concurrently. `Model::images`
+  /// order, errors and warnings are the same as with serial decoding.
+  /// A user supplied LoadImageData callback must be thread-safe.
+  /// Ignored(serial) when built with TINYGLTF_NO_THREADS.
+  ///
+  void SetImageDecodeThreads(int num_threads) {
+    image_decode_threads_ = num_threads;
+  }
+
+  int GetImageDecodeThreads() const { return image_decode_threads_; }
+
   ///
   /// Set maximum allowed external file size in bytes.
   /// Default: 2GB
@@ -1568,6 +1652,8 @@ class TinyGLTF {
   const unsigned char *bin_data_ = nullptr;
   size_t bin_size_ = 0;
   bool is_binary_ = false;
+  std::shared_ptr<const MappedFile> bin_mapping_;  // Owner of `bin_data_`
+                                                   // when memory mapped.
 
   ParseStrictness strictness_ = ParseStrictness::Strict;
 
@@ -1580,6 +1666,10 @@ class TinyGLTF {
 
   bool images_as_is_ = false; /// Default false (decode/decompress images)
 
+  bool memory_map_binary_ = false;  /// Default false (read GLB into memory)
+
+  int image_decode_threads_ = 1;  /// Default 1 (decode images serially)
+
   size_t max_external_file_size_{
       size_t((std::numeric_limits<int32_t>::max)())};  // Default 2GB
 
@@ -1646,9 +1736,36 @@ class TinyGLTF {
 
 #include <cstdio>
 #include <fstream>
+
+#if (defined(__unix__) || defined(__APPLE__)) && \
+    !defined(TINYGLTF_ANDROID_LOAD_FROM_ASSETS)
+#define TINYGLTF_INTERNAL_HAS_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
 #endif
 #include <sstream>
 
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+// No std::thread without -pthread in Emscripten builds.
+#ifndef TINYGLTF_NO_THREADS
+#define TINYGLTF_NO_THREADS
+#endif
+#endif
+
+#ifndef TINYGLTF_NO_THREADS
+#include <atomic>
+#include <thread>
+#endif
+
+// Scoped timing probe for loading stages. Define it before including the
+// implementation (e.g. to a profiler's scope macro); empty by default, so
+// the probes cost nothing.
+#ifndef TINYGLTF_PROFILE_SCOPE
+#define TINYGLTF_PROFILE_SCOPE(name)
+#endif
+
 #ifdef __clang__
 // Disable some warnings for external files.
 #pragma clang diagnostic push
@@ -1997,7 +2114,11 @@ bool Asset::operator==(const Asset &other) const {
          this->minVersion == other.minVersion && this->version == other.version;
 }
 bool Buffer::operator==(const Buffer &other) const {
-  return this->data == other.data && this->extensions == other.extensions &&
+  return this->DataSize() == other.DataSize() &&
+         (this->DataSize() == 0 ||
+          std::memcmp(this->DataPtr(), other.DataPtr(), this->DataSize()) ==
+              0) &&
+         this->extensions == other.extensions &&
          this->extras == other.extras && this->name == other.name &&
          this->uri == other.uri;
 }
@@ -2607,6 +2728,7 @@ void TinyGLTF::RemoveImageLoader() {
 bool LoadImageData(Image *image, const int image_idx, std::string *err,
                    std::string *warn, int req_width, int req_height,
                    const unsigned char *bytes, int size, void *user_data) {
+  TINYGLTF_PROFILE_SCOPE("tinygltf::LoadImageData");
   (void)warn;
 
   LoadImageDataOption option;
@@ -2738,6 +2860,38 @@ bool LoadImageData(Image *image, const int image_idx, std::string *err,
 }
 #endif
 
+#ifndef TINYGLTF_NO_STB_IMAGE
+bool DecodeImageAsIs(const Image &encoded, Image *decoded, int image_idx,
+                     std::string *err, std::string *warn,
+                     bool preserve_channels) {
+  if (!encoded.as_is) {
+    *decoded = encoded;
+    return true;
+  }
+
+  if (encoded.image.empty()) {
+    if (err) {
+      (*err) += "Image data is empty for image[" + std::to_string(image_idx) +
+                "] name = \"" + encoded.name + "\"\n";
+    }
+    return false;
+  }
+
+  LoadImageDataOption option;
+  option.preserve_channels = preserve_channels;
+  option.as_is = false;
+
+  decoded->name = encoded.name;
+  decoded->mimeType = encoded.mimeType;
+  decoded->uri = encoded.uri;
+  decoded->bufferView = encoded.bufferView;
+
+  return LoadImageData(decoded, image_idx, err, warn, 0, 0,
+                       encoded.image.data(),
+                       static_cast<int>(encoded.image.size()), &option);
+}
+#endif
+
 void TinyGLTF::SetImageWriter(WriteImageDataFunction func, void *user_data) {
   WriteImageData = std::move(func);
   write_image_user_data_ = user_data;
@@ -3127,6 +3281,7 @@ bool GetFileSizeInBytes(size_t *filesize_out, std::string *err,
 
 bool ReadWholeFile(std::vector<unsigned char> *out, std::string *err,
                    const std::string &filepath, void *) {
+  TINYGLTF_PROFILE_SCOPE("tinygltf::ReadWholeFile");
 #ifdef TINYGLTF_ANDROID_LOAD_FROM_ASSETS
   if (asset_manager) {
     AAsset *asset = AAssetManager_open(asset_manager, filepath.c_str(),
@@ -3261,6 +3416,71 @@ bool WriteWholeFile(std::string *err, const std::string &filepath,
 
 #endif  // TINYGLTF_NO_FS
 
+MappedFile::~MappedFile() {
+#ifdef TINYGLTF_INTERNAL_HAS_MMAP
+  if (mapped_) {
+    munmap(const_cast<unsigned char *>(data_), size_);
+  }
+#endif
+}
+
+std::shared_ptr<MappedFile> MappedFile::Open(const std::string &filepath,
+                                             std::string *err) {
+#ifdef TINYGLTF_NO_FS
+  (void)filepath;
+  if (err) {
+    (*err) += "MappedFile is not available with TINYGLTF_NO_FS.\n";
+  }
+  return nullptr;
+#else
+  std::shared_ptr<MappedFile> file(new MappedFile());
+
+#ifdef TINYGLTF_INTERNAL_HAS_MMAP
+  int fd = open(filepath.c_str(), O_RDONLY);
+  if (fd < 0) {
+    if (err) {
+      (*err) += "File open error : " + filepath + "\n";
+    }
+    return nullptr;
+  }
+
+  struct stat st;
+  if ((fstat(fd, &st) != 0) || !S_ISREG(st.st_mode) || (st.st_size <= 0)) {
+    close(fd);
+    if (err) {
+      (*err) += "Invalid file size : " + filepath +
+                " (does the path point to a directory?)";
+    }
+    return nullptr;
+  }
+
+  const size_t sz = static_cast<size_t>(st.st_size);
+  void *addr = mmap(nullptr, sz, PROT_READ, MAP_PRIVATE, fd, 0);
+  // The mapping holds its own reference to the file.
+  close(fd);
+
+  if (addr != MAP_FAILED) {
+    file->data_ = reinterpret_cast<const unsigned char *>(addr);
+    file->size_ = sz;
+    file->mapped_ = true;
+    return file;
+  }
+  // mmap can fail on special filesystems, read the file instead.
+#endif
+
+  std::string read_err;
+  if (!ReadWholeFile(&file->fallback_, &read_err, filepath, nullptr)) {
+    if (err) {
+      (*err) += read_err;
+    }
+    return nullptr;
+  }
+  file->data_ = file->fallback_.data();
+  file->size_ = file->fallback_.size();
+  return file;
+#endif
+}
+
 static std::string MimeToExt(const std::string &mimeType) {
   if (mimeType == "image/jpeg") {
     return "jpg";
@@ -3367,6 +3587,7 @@ bool IsDataURI(const std::string &in) {
 
 bool DecodeDataURI(std::vector<unsigned char> *out, std::string &mime_type,
                    const std::string &in, size_t reqBytes, bool checkSize) {
+  TINYGLTF_PROFILE_SCOPE("tinygltf::DecodeDataURI (base64)");
   std::string header = "data:application/octet-stream;base64,";
   std::string data;
   if (in.find(header) == 0) {
@@ -4526,7 +4747,9 @@ static bool ParseBuffer(Buffer *buffer, std::string *err, const detail::json &o,
                         const std::string &basedir,
                         const size_t max_buffer_size, bool is_binary = false,
                         const unsigned char *bin_data = nullptr,
-                        size_t bin_size = 0) {
+                        size_t bin_size = 0,
+                        const std::shared_ptr<const MappedFile> &bin_mapping =
+                            nullptr) {
   size_t byteLength;
   if (!ParseUnsignedProperty(&byteLength, err, o, "byteLength", true,
                              "Buffer")) {
@@ -4603,9 +4826,17 @@ static bool ParseBuffer(Buffer *buffer, std::string *err, const detail::json &o,
         return false;
       }
 
-      // Read buffer data
-      buffer->data.resize(static_cast<size_t>(byteLength));
-      memcpy(&(buffer->data.at(0)), bin_data, static_cast<size_t>(byteLength));
+      if (bin_mapping) {
+        // Reference the BIN chunk inside the file mapping, no copy.
+        buffer->mapping = bin_mapping;
+        buffer->mapped_data = bin_data;
+        buffer->mapped_size = static_cast<size_t>(byteLength);
+      } else {
+        // Read buffer data
+        buffer->data.resize(static_cast<size_t>(byteLength));
+        memcpy(&(buffer->data.at(0)), bin_data,
+               static_cast<size_t>(byteLength));
+      }
     }
 
   } else {
@@ -4976,7 +5207,7 @@ static bool ParseDracoExtension(Primitive *primitive, Model *model,
   view.dracoDecoded = true;
 
   const char *bufferViewData =
-      reinterpret_cast<const char *>(buffer.data.data() + view.byteOffset);
+      reinterpret_cast<const char *>(buffer.DataPtr() + view.byteOffset);
   size_t bufferViewSize = view.byteLength;
 
   // decode draco
@@ -5981,6 +6212,7 @@ bool TinyGLTF::LoadFromString(Model *model, std::string *err, std::string *warn,
                               unsigned int json_str_length,
                               const std::string &base_dir,
                               unsigned int check_sections) {
+  TINYGLTF_PROFILE_SCOPE("tinygltf::LoadFromString");
   if (json_str_length < 4) {
     if (err) {
       (*err) = "JSON string too short.\n";
@@ -5994,6 +6226,7 @@ bool TinyGLTF::LoadFromString(Model *model, std::string *err, std::string *warn,
      defined(_CPPUNWIND)) &&                               \
     !defined(TINYGLTF_NOEXCEPTION)
   try {
+    TINYGLTF_PROFILE_SCOPE("tinygltf::JsonParse");
     detail::JsonParse(v, json_str, json_str_length, true);
 
   } catch (const std::exception &e) {
@@ -6004,6 +6237,7 @@ bool TinyGLTF::LoadFromString(Model *model, std::string *err, std::string *warn,
   }
 #else
   {
+    TINYGLTF_PROFILE_SCOPE("tinygltf::JsonParse");
     detail::JsonParse(v, json_str, json_str_length);
 
     if (!detail::IsObject(v)) {
@@ -6155,7 +6389,7 @@ bool TinyGLTF::LoadFromString(Model *model, std::string *err, std::string *warn,
       if (!ParseBuffer(&buffer, err, o,
                        store_original_json_for_extras_and_extensions_, &fs,
                        &uri_cb, base_dir, max_external_file_size_, is_binary_,
-                       bin_data_, bin_size_)) {
+                       bin_data_, bin_size_, bin_mapping_)) {
         return false;
       }
 
@@ -6402,6 +6636,46 @@ bool TinyGLTF::LoadFromString(Model *model, std::string *err, std::string *warn,
     load_image_user_data = reinterpret_cast<void *>(&load_image_option);
   }
 
+  // Images whose decoding is deferred to the parallel stage below.
+  struct DeferredImage {
+    bool pending{false};
+    const unsigned char *bytes{nullptr};
+    size_t size{0};
+    std::vector<unsigned char> owned;  // data URI / external file contents
+    int req_width{0};
+    int req_height{0};
+  };
+  std::vector<DeferredImage> deferred_images;
+
+  int decode_threads = image_decode_threads_;
+#ifdef TINYGLTF_NO_THREADS
+  decode_threads = 1;
+#else
+  if (decode_threads <= 0) {
+    decode_threads = int(std::thread::hardware_concurrency());
+  }
+#endif
+  const bool defer_image_decoding =
+      (decode_threads > 1) && (LoadImageData != nullptr);
+
+  // Records the encoded bytes instead of decoding them.
+  LoadImageDataFunction DeferImageData =
+      [&deferred_images](Image *, const int image_idx, std::string *,
+                         std::string *, int req_width, int req_height,
+                         const unsigned char *bytes, int size, void *) {
+        if (deferred_images.size() <= size_t(image_idx)) {
+          deferred_images.resize(size_t(image_idx) + 1);
+        }
+        DeferredImage &d = deferred_images[size_t(image_idx)];
+        d.pending = true;
+        d.owned.assign(bytes, bytes + size);
+        d.bytes = d.owned.data();
+        d.size = d.owned.size();
+        d.req_width = req_width;
+        d.req_height = req_height;
+        return true;
+      };
+
   {
     int idx = 0;
     bool success = ForEachInArray(v, "images", [&](const detail::json &o) {
@@ -6415,7 +6689,9 @@ bool TinyGLTF::LoadFromString(Model *model, std::string *err, std::string *warn,
       if (!ParseImage(&image, idx, err, warn, o,
                       store_original_json_for_extras_and_extensions_, base_dir,
                       max_external_file_size_, &fs, &uri_cb,
-                      this->LoadImageData, load_image_user_data)) {
+                      defer_image_decoding ? DeferImageData
+                                           : this->LoadImageData,
+                      load_image_user_data)) {
         return false;
       }
 
@@ -6443,7 +6719,7 @@ bool TinyGLTF::LoadFromString(Model *model, std::string *err, std::string *warn,
           return false;
         }
         const Buffer &buffer = model->buffers[size_t(bufferView.buffer)];
-        if (bufferView.byteOffset >= buffer.data.size()) {
+        if (bufferView.byteOffset >= buffer.DataSize()) {
           if (err) {
             std::stringstream ss;
             ss << "image[" << idx << "] bufferView \"" << image.bufferView
@@ -6459,12 +6735,27 @@ bool TinyGLTF::LoadFromString(Model *model, std::string *err, std::string *warn,
           }
           return false;
         }
-        bool ret = LoadImageData(
-            &image, idx, err, warn, image.width, image.height,
-            &buffer.data[bufferView.byteOffset],
-            static_cast<int>(bufferView.byteLength), load_image_user_data);
-        if (!ret) {
-          return false;
+
+        if (defer_image_decoding) {
+          // Buffers are fully loaded and not modified from here on, so the
+          // bytes can be referenced in place.
+          if (deferred_images.size() <= size_t(idx)) {
+            deferred_images.resize(size_t(idx) + 1);
+          }
+          DeferredImage &d = deferred_images[size_t(idx)];
+          d.pending = true;
+          d.bytes = buffer.DataPtr() + bufferView.byteOffset;
+          d.size = bufferView.byteLength;
+          d.req_width = image.width;
+          d.req_height = image.height;
+        } else {
+          bool ret = LoadImageData(
+              &image, idx, err, warn, image.width, image.height,
+              buffer.DataPtr() + bufferView.byteOffset,
+              static_cast<int>(bufferView.byteLength), load_image_user_data);
+          if (!ret) {
+            return false;
+          }
         }
       }
 
@@ -6478,6 +6769,61 @@ bool TinyGLTF::LoadFromString(Model *model, std::string *err, std::string *warn,
     }
   }
 
+#ifndef TINYGLTF_NO_THREADS
+  if (defer_image_decoding) {
+    deferred_images.resize(model->images.size());
+
+    const size_t num_images = deferred_images.size();
+    std::vector<std::string> image_errs(num_images);
+    std::vector<std::string> image_warns(num_images);
+    std::vector<char> image_ok(num_images, 1);
+    std::atomic<size_t> next_image{0};
+
+    auto decode_worker = [&]() {
+      for (;;) {
+        const size_t i = next_image.fetch_add(1);
+        if (i >= num_images) {
+          return;
+        }
+        DeferredImage &d = deferred_images[i];
+        if (!d.pending) {
+          continue;
+        }
+        image_ok[i] = LoadImageData(
+            &model->images[i], int(i), &image_errs[i], &image_warns[i],
+            d.req_width, d.req_height, d.bytes, static_cast<int>(d.size),
+            load_image_user_data);
+        // Release the encoded copy as soon as it is decoded.
+        std::vector<unsigned char>().swap(d.owned);
+      }
+    };
+
+    size_t num_workers = (std::min)(size_t(decode_threads), num_images);
+    std::vector<std::thread> workers;
+    for (size_t i = 1; i < num_workers; i++) {
+      workers.emplace_back(decode_worker);
+    }
+    decode_worker();
+    for (auto &worker : workers) {
+      worker.join();
+    }
+
+    // Report in image order and stop at the first failure, as the serial
+    // path does.
+    for (size_t i = 0; i < num_images; i++) {
+      if (warn) {
+        (*warn) += image_warns[i];
+      }
+      if (err) {
+        (*err) += image_errs[i];
+      }
+      if (!image_ok[i]) {
+        return false;
+      }
+    }
+  }
+#endif
+
   // 12. Parse Texture
   {
     bool success = ForEachInArray(v, "textures", [&](const detail::json &o) {
@@ -6928,6 +7274,7 @@ bool TinyGLTF::LoadBinaryFromFile(Model *model, std::string *err,
                                   std::string *warn,
                                   const std::string &filename,
                                   unsigned int check_sections) {
+  TINYGLTF_PROFILE_SCOPE("tinygltf::LoadBinaryFromFile");
   std::stringstream ss;
 
   if (fs.ReadWholeFile == nullptr) {
@@ -6940,6 +7287,39 @@ bool TinyGLTF::LoadBinaryFromFile(Model *model, std::string *err,
     return false;
   }
 
+  std::string basedir = GetBaseDir(filename);
+
+  if (memory_map_binary_) {
+    std::string fileerr;
+    std::shared_ptr<MappedFile> mapping;
+    {
+      TINYGLTF_PROFILE_SCOPE("tinygltf: map file");
+      mapping = MappedFile::Open(filename, &fileerr);
+    }
+    if (!mapping) {
+      ss << "Failed to map file: " << filename << ": " << fileerr << std::endl;
+      if (err) {
+        (*err) = ss.str();
+      }
+      return false;
+    }
+
+    if (mapping->size() > (std::numeric_limits<unsigned int>::max)()) {
+      if (err) {
+        (*err) = "Invalid glTF binary. GLB data exceeds 4GB.";
+      }
+      return false;
+    }
+
+    bin_mapping_ = mapping;
+    bool ret = LoadBinaryFromMemory(model, err, warn, mapping->data(),
+                                    static_cast<unsigned int>(mapping->size()),
+                                    basedir, check_sections);
+    bin_mapping_.reset();
+
+    return ret;
+  }
+
   std::vector<unsigned char> data;
   std::string fileerr;
   bool fileread = fs.ReadWholeFile(&data, &fileerr, filename, fs.user_data);
@@ -6951,8 +7331,6 @@ bool TinyGLTF::LoadBinaryFromFile(Model *model, std::string *err,
     return false;
   }
 
-  std::string basedir = GetBaseDir(filename);
-
   bool ret = LoadBinaryFromMemory(model, err, warn, &data.at(0),
                                   static_cast<unsigned int>(data.size()),
                                   basedir, check_sections);
@@ -7492,8 +7870,8 @@ static void SerializeGltfAsset(const Asset &asset, detail::json &o) {
 
 static void SerializeGltfBufferBin(const Buffer &buffer, detail::json &o,
                                    std::vector<unsigned char> &binBuffer) {
-  SerializeNumberProperty("byteLength", buffer.data.size(), o);
-  binBuffer = buffer.data;
+  SerializeNumberProperty("byteLength", buffer.DataSize(), o);
+  binBuffer.assign(buffer.DataPtr(), buffer.DataPtr() + buffer.DataSize());
 
   if (buffer.name.size()) SerializeStringProperty("name", buffer.name, o);
 
@@ -7501,8 +7879,15 @@ static void SerializeGltfBufferBin(const Buffer &buffer, detail::json &o,
 }
 
 static void SerializeGltfBuffer(const Buffer &buffer, detail::json &o) {
-  SerializeNumberProperty("byteLength", buffer.data.size(), o);
-  SerializeGltfBufferData(buffer.data, o);
+  SerializeNumberProperty("byteLength", buffer.DataSize(), o);
+  if (buffer.mapping) {
+    SerializeGltfBufferData(
+        std::vector<unsigned char>(buffer.DataPtr(),
+                                   buffer.DataPtr() + buffer.DataSize()),
+        o);
+  } else {
+    SerializeGltfBufferData(buffer.data, o);
+  }
 
   if (buffer.name.size()) SerializeStringProperty("name", buffer.name, o);
 
@@ -7512,8 +7897,16 @@ static void SerializeGltfBuffer(const Buffer &buffer, detail::json &o) {
 static bool SerializeGltfBuffer(const Buffer &buffer, detail::json &o,
                                 const std::string &binFilename,
                                 const std::string &binUri) {
-  if (!SerializeGltfBufferData(buffer.data, binFilename)) return false;
-  SerializeNumberProperty("byteLength", buffer.data.size(), o);
+  if (buffer.mapping) {
+    if (!SerializeGltfBufferData(
+            std::vector<unsigned char>(buffer.DataPtr(),
+                                       buffer.DataPtr() + buffer.DataSize()),
+            binFilename))
+      return false;
+  } else {
+    if (!SerializeGltfBufferData(buffer.data, binFilename)) return false;
+  }
+  SerializeNumberProperty("byteLength", buffer.DataSize(), o);
   SerializeStringProperty("uri", binUri, o);
 
   if (buffer.name.size()) SerializeStringProperty("name", buffer.name, o);
@@ -0,0 +1,162 @@
+// Kompaktowy format wierzchołka (16 zamiast 32 bajtów) do uploadu na GPU:
+// pozycje jako znormalizowane int16 względem AABB meshu, normalne zakodowane
+// oktaedrycznie w 2 x int16, texcoordy jako znormalizowane uint16 względem
+// zakresu UV. Dekwantyzacja odbywa się w vertex shaderze (skala + przesunięcie).
+#ifndef VERTEX_QUANTIZATION_H_
+#define VERTEX_QUANTIZATION_H_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+struct QuantizedVertex {
+    int16_t position[4]; // xyz znormalizowane do AABB, w = 0 (wyrównanie do 4 bajtów)
+    int16_t normal[2];   // Kodowanie oktaedryczne
+    uint16_t texcoord[2];
+};
+static_assert(sizeof(QuantizedVertex) == 16, "QuantizedVertex musi mieć 16 bajtów");
+
+// Parametry dekwantyzacji jednego VBO: wartość = znormalizowana * scale + offset
+struct QuantizationParams {
+    glm::vec3 positionScale = glm::vec3(1.0f);
+    glm::vec3 positionOffset = glm::vec3(0.0f);
+    glm::vec4 texcoordTransform = glm::vec4(1.0f, 1.0f, 0.0f, 0.0f); // xy skala, zw przesunięcie
+};
+
+// Zbiorczy raport błędu dla całego assetu (maksima po wszystkich VBO)
+struct QuantizationReport {
+    size_t vertices = 0;
+    size_t floatBytes = 0;
+    size_t quantizedBytes = 0;
+    double maxPositionError = 0.0;    // W jednostkach meshu
+    double maxPositionErrorRel = 0.0; // Względem przekątnej AABB meshu
+    double maxNormalErrorDeg = 0.0;
+    double maxTexcoordError = 0.0;    // W jednostkach UV
+};
+
+inline int16_t QuantizeSnorm16(float v) {
+    return (int16_t)std::lround(std::min(std::max(v, -1.0f), 1.0f) * 32767.0f);
+}
+
+inline float DequantizeSnorm16(int16_t v) {
+    return std::max(v / 32767.0f, -1.0f);
+}
+
+// --- Dekodowanie oktaedryczne (to samo co OctDecode w shaderze) ---
+inline glm::vec3 OctDecode(float x, float y) {
+    glm::vec3 n(x, y, 1.0f - std::fabs(x) - std::fabs(y));
+    float t = std::max(-n.z, 0.0f);
+    n.x += (n.x >= 0.0f) ? -t : t;
+    n.y += (n.y >= 0.0f) ? -t : t;
+    return glm::normalize(n);
+}
+
+// --- Kodowanie oktaedryczne; z czterech zaokrągleń wybieramy najbliższe oryginałowi ---
+inline void OctEncode(const glm::vec3& normal, int16_t out[2]) {
+    float length1 = std::fabs(normal.x) + std::fabs(normal.y) + std::fabs(normal.z);
+    if (length1 == 0.0f) { // Brak normalnej - cokolwiek poprawnego
+        out[0] = out[1] = 0;
+        return;
+    }
+    glm::vec3 n = normal / length1;
+    float x = n.x, y = n.y;
+    if (n.z < 0.0f) {
+        float ox = x;
+        x = (1.0f - std::fabs(y)) * (ox >= 0.0f ? 1.0f : -1.0f);
+        y = (1.0f - std::fabs(ox)) * (y >= 0.0f ? 1.0f : -1.0f);
+    }
+
+    glm::vec3 target = glm::normalize(normal);
+    float bestDot = -2.0f;
+    for (int i = 0; i < 4; ++i) {
+        float qx = (i & 1) ? std::ceil(x * 32767.0f) : std::floor(x * 32767.0f);
+        float qy = (i & 2) ? std::ceil(y * 32767.0f) : std::floor(y * 32767.0f);
+        qx = std::min(std::max(qx, -32767.0f), 32767.0f);
+        qy = std::min(std::max(qy, -32767.0f), 32767.0f);
+        float d = glm::dot(OctDecode(qx / 32767.0f, qy / 32767.0f), target);
+        if (d > bestDot) {
+            bestDot = d;
+            out[0] = (int16_t)qx;
+            out[1] = (int16_t)qy;
+        }
+    }
+}
+
+// --- Kwantyzacja tablicy Vertex; błędy dopisywane do raportu ---
+template <typename VertexT>
+inline std::vector<QuantizedVertex> QuantizeVertices(const VertexT* vertices, size_t count,
+                                                     QuantizationParams& params, QuantizationReport& report) {
+    std::vector<QuantizedVertex> out(count);
+    if (count == 0) return out;
+
+    glm::vec3 posMin(vertices[0].position), posMax(vertices[0].position);
+    glm::vec2 uvMin(vertices[0].texcoord), uvMax(vertices[0].texcoord);
+    for (size_t i = 1; i < count; ++i) {
+        posMin = glm::min(posMin, vertices[i].position);
+        posMax = glm::max(posMax, vertices[i].position);
+        uvMin = glm::min(uvMin, vertices[i].texcoord);
+        uvMax = glm::max(uvMax, vertices[i].texcoord);
+    }
+
+    // Płaska oś (zerowy rozmiar) - skala 1, żeby nie dzielić przez zero
+    glm::vec3 halfExtent = (posMax - posMin) * 0.5f;
+    glm::vec3 center = (posMax + posMin) * 0.5f;
+    for (int a = 0; a < 3; ++a) {
+        if (halfExtent[a] <= 0.0f) halfExtent[a] = 1.0f;
+    }
+    glm::vec2 uvRange = uvMax - uvMin;
+    for (int a = 0; a < 2; ++a) {
+        if (uvRange[a] <= 0.0f) uvRange[a] = 1.0f;
+    }
+
+    params.positionScale = halfExtent;
+    params.positionOffset = center;
+    params.texcoordTransform = glm::vec4(uvRange.x, uvRange.y, uvMin.x, uvMin.y);
+
+    const double diagonal = std::max(1e-12, (double)glm::length(posMax - posMin));
+    double maxPos = 0.0, maxNormalCos = 1.0, maxUv = 0.0;
+
+    for (size_t i = 0; i < count; ++i) {
+        const VertexT& v = vertices[i];
+        QuantizedVertex& q = out[i];
+
+        glm::vec3 p = (v.position - center) / halfExtent;
+        for (int a = 0; a < 3; ++a) q.position[a] = QuantizeSnorm16(p[a]);
+        q.position[3] = 0;
+
+        OctEncode(v.normal, q.normal);
+
+        glm::vec2 t = (v.texcoord - uvMin) / uvRange;
+        for (int a = 0; a < 2; ++a) {
+            q.texcoord[a] = (uint16_t)std::lround(std::min(std::max(t[a], 0.0f), 1.0f) * 65535.0f);
+        }
+
+        // Błąd po pełnym cyklu kwantyzacja -> dekwantyzacja (jak w shaderze)
+        glm::vec3 dp(DequantizeSnorm16(q.position[0]), DequantizeSnorm16(q.position[1]), DequantizeSnorm16(q.position[2]));
+        maxPos = std::max(maxPos, (double)glm::length(dp * halfExtent + center - v.position));
+
+        if (glm::dot(v.normal, v.normal) > 0.0f) {
+            glm::vec3 dn = OctDecode(DequantizeSnorm16(q.normal[0]), DequantizeSnorm16(q.normal[1]));
+            maxNormalCos = std::min(maxNormalCos, (double)glm::dot(dn, glm::normalize(v.normal)));
+        }
+
+        glm::vec2 dt = glm::vec2(q.texcoord[0], q.texcoord[1]) / 65535.0f * uvRange + uvMin;
+        maxUv = std::max(maxUv, (double)std::max(std::fabs(dt.x - v.texcoord.x), std::fabs(dt.y - v.texcoord.y)));
+    }
+
+    report.vertices += count;
+    report.floatBytes += count * sizeof(VertexT);
+    report.quantizedBytes += count * sizeof(QuantizedVertex);
+    report.maxPositionError = std::max(report.maxPositionError, maxPos);
+    report.maxPositionErrorRel = std::max(report.maxPositionErrorRel, maxPos / diagonal);
+    report.maxNormalErrorDeg = std::max(report.maxNormalErrorDeg,
+                                        std::acos(std::min(1.0, std::max(-1.0, maxNormalCos))) * 180.0 / 3.14159265358979);
+    report.maxTexcoordError = std::max(report.maxTexcoordError, maxUv);
+    return out;
+}
+
+#endif  // VERTEX_QUANTIZATION_H_
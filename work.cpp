@@ -208,13 +208,15 @@ bool LoadModelToOpenGL(const tinygltf::Model& model, ModelGL& modelGL) {
             const auto& normView = (normIndex != -1) ? model.bufferViews[normAccessor.bufferView] : tinygltf::BufferView{};
             const auto& texView = (texIndex != -1) ? model.bufferViews[texAccessor.bufferView] : tinygltf::BufferView{};
 
+            // Pusty bufor jako l-wartość - warunek ?: nie kopiuje wtedy całego model.buffers[]
+            static const tinygltf::Buffer emptyBuffer;
             const auto& posBuffer = model.buffers[posView.buffer];
-            const auto& normBuffer = (normIndex != -1) ? model.buffers[normView.buffer] : tinygltf::Buffer{};
-            const auto& texBuffer = (texIndex != -1) ? model.buffers[texView.buffer] : tinygltf::Buffer{};
+            const tinygltf::Buffer& normBuffer = (normIndex != -1) ? model.buffers[normView.buffer] : emptyBuffer;
+            const tinygltf::Buffer& texBuffer = (texIndex != -1) ? model.buffers[texView.buffer] : emptyBuffer;
 
-            const float* positions = reinterpret_cast<const float*>(&posBuffer.data[posView.byteOffset + posAccessor.byteOffset]);
-            const float* normals = (normIndex != -1) ? reinterpret_cast<const float*>(&normBuffer.data[normView.byteOffset + normAccessor.byteOffset]) : nullptr;
-            const float* texcoords = (texIndex != -1) ? reinterpret_cast<const float*>(&texBuffer.data[texView.byteOffset + texAccessor.byteOffset]) : nullptr;
+            const float* positions = reinterpret_cast<const float*>(posBuffer.DataPtr() + posView.byteOffset + posAccessor.byteOffset);
+            const float* normals = (normIndex != -1) ? reinterpret_cast<const float*>(normBuffer.DataPtr() + normView.byteOffset + normAccessor.byteOffset) : nullptr;
+            const float* texcoords = (texIndex != -1) ? reinterpret_cast<const float*>(texBuffer.DataPtr() + texView.byteOffset + texAccessor.byteOffset) : nullptr;
 
             int vertexCount = posAccessor.count;
             std::vector<Vertex> vertices(vertexCount);
@@ -238,7 +240,7 @@ bool LoadModelToOpenGL(const tinygltf::Model& model, ModelGL& modelGL) {
             const auto& indexBuffer = model.buffers[indexView.buffer];
 
             const unsigned short* indices = reinterpret_cast<const unsigned short*>(
-                &indexBuffer.data[indexView.byteOffset + indexAccessor.byteOffset]);
+                indexBuffer.DataPtr() + indexView.byteOffset + indexAccessor.byteOffset);
 
             newMesh.indexCount = indexAccessor.count;
 
@@ -347,6 +349,8 @@ int main() {
 
     tinygltf::Model model;
     tinygltf::TinyGLTF loader;
+    loader.SetMemoryMapBinary(true); // Bufory GLB czytane bezpośrednio z mapowania pliku, bez kopii
+    loader.SetImageDecodeThreads(0); // Dekodowanie obrazów na wszystkich rdzeniach (w wasm bez pthreads - szeregowo)
     std::string err, warn;
     if (!loader.LoadBinaryFromFile(&model, &err, &warn, "asserts/earth_globe_hologram_2mb_looping_animation.glb")) {
         std::cerr << "Failed to load model: " << err << std::endl;